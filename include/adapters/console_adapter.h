@@ -5,18 +5,19 @@
 #ifndef CONSOLE_ADAPTER_H
 #define CONSOLE_ADAPTER_H
 
-#define SILENCE_COUT_BEGIN \
-std::streambuf* __cout_original_buf = std::cout.rdbuf(); \
-std::stringstream __cout_silent_buffer; \
-std::cout.rdbuf(__cout_silent_buffer.rdbuf());
-
-#define SILENCE_COUT_END \
-std::cout.rdbuf(__cout_original_buf);
-
 #include <memory>
 
 #include "../core/console.h"
+#include "../core/job_manager.h"
+#include "../core/query_server.h"
+#include "../backend/generators.h"
 #include "../backend/graph_gen.h"
+#include "../backend/graph_workspace.h"
+#include "../backend/hub_labels.h"
+#include "../backend/landmarks.h"
+#include "../backend/point_queries.h"
+#include "../backend/reachability.h"
+#include "../backend/result_cache.h"
 
 class GraphConsoleAdapter {
     public:
@@ -26,29 +27,185 @@ class GraphConsoleAdapter {
 
     void run();
 
+    /**
+     * @brief Runs commands from a stream non-interactively (no prompt, colours or banner)
+     *
+     * @param input Stream with one command per line
+     * @return EXIT_SUCCESS if every command succeeded, EXIT_FAILURE otherwise
+     */
+    int run_batch(std::istream& input);
+
     private:
     Console console;
 
-    bool graphs_created;
-    std::unique_ptr<Graph> graph;
-    int n;
+    GraphWorkspace workspace;
     bool weighted;
     bool directed;
 
+    // From the [performance] config section; see apply_performance_config
+    AnalysisOptions analysis_options;
+    int dense_matrix_limit = default_dense_matrix_limit;
+    std::string spill_dir;
+
+    static constexpr const char* default_graph_name = "main";
+
+    /**
+     * @brief Calls fn with the policy tags (see graph_policies.h) matching the weighted/directed flags
+     *
+     * The single place where runtime flags select a compiled kernel variant;
+     * commands use it to pick a kernel and then call it without further checks.
+     */
+    template <typename Fn>
+    decltype(auto) dispatch_policies(Fn&& fn) const;
+
     void cleanup();
+
+    /**
+     * @brief Returns the current graph, or prints an error and returns nullptr if there is none
+     */
+    std::shared_ptr<const Graph> require_graph() const;
     void register_graph_commands();
     std::string find_config_file(const std::string& filename, const std::vector<std::string>& search_paths);
     std::string get_default_config_path();
+    void apply_memory_budget(const std::string& value);
+
+    /**
+     * @brief Applies the [performance] config section: threads, engine, memory budget, dense threshold, stdout buffering
+     *
+     * Invalid values are reported and replaced by their defaults.
+     */
+    void apply_performance_config(const PerformanceConfig& performance);
+
+    // Declared before jobs so that it outlives the worker thread that stores results into it
+    ResultCache cache;
+    JobManager jobs;
+
+    // Point queries of the console thread reuse one workspace; the incoming adjacency is kept for one graph version
+    SearchWorkspace point_workspace;
+    std::shared_ptr<const ReverseAdjacency> reverse_adjacency;
+    std::uint64_t reverse_version = 0;
+
+    /**
+     * @brief Returns the incoming adjacency of the current graph for backward searches
+     *
+     * Built on first use and kept until the graph changes; nullptr for
+     * undirected graphs, whose adjacency already works in both directions.
+     */
+    std::shared_ptr<const ReverseAdjacency> incoming_adjacency(const Graph& graph);
+
+    std::shared_ptr<const ReachabilityIndex> reachability;
+    std::uint64_t reachability_version = 0;
+
+    /**
+     * @brief Returns the reachability index of the current graph
+     *
+     * Built on first use and kept until the graph changes. Returns nullptr,
+     * after printing why, if the closure does not fit the memory budget.
+     */
+    std::shared_ptr<const ReachabilityIndex> reachability_index(const Graph& graph);
+
+    // Built by 'landmarks build' for one graph version; used by 'dist ~u v' and 'dist --alt u v'
+    std::shared_ptr<const LandmarkTable> landmark_table;
+    std::uint64_t landmark_version = 0;
 
-    void cmd_create(const std::vector<std::string>& args);
+    /**
+     * @brief Returns the landmark table of the current graph, or prints a hint and returns nullptr
+     */
+    std::shared_ptr<const LandmarkTable> current_landmarks() const;
+
+    // Built by 'labels build' or read by 'labels load' for one graph version; answers 'dist u v' exactly
+    std::shared_ptr<const HubLabels> hub_labels;
+    std::uint64_t hub_labels_version = 0;
+
+    /**
+     * @brief Returns the hub labels of the current graph, or nullptr if there are none
+     */
+    std::shared_ptr<const HubLabels> current_hub_labels() const;
+
+    // Declared after cache so that it stops before the cache its handler uses is destroyed
+    std::unique_ptr<QueryServer> server;
+
+    /**
+     * @brief Runs a task as a job; waits for it in the foreground unless background is set
+     */
+    void run_job(const std::string& description, JobManager::Task task, bool background);
+
+    /**
+     * @brief Waits for a job, showing live progress, and prints its output
+     *
+     * @return true if the job completed successfully
+     */
+    bool wait_job(int id);
+
+    /**
+     * @brief Removes a trailing "&" argument
+     *
+     * @return true if the command should run in the background
+     */
+    static bool strip_background_flag(Console::CommandArgs& args);
+
+    /**
+     * @brief Drops cached results of graph versions no longer in the workspace
+     */
+    void prune_cache();
+
+    static void write_find(const CachedRow& row, int start_v, std::ostream& out);
+    static void write_analysis(const AnalysisResult& result, std::ostream& out);
+
+    void cmd_create(Console::CommandArgs args);
+    void create_model(const std::string& name, Console::CommandArgs args);
+
+    /**
+     * @brief Checks that a graph of the given size fits the memory budget, counting the graph it replaces
+     *
+     * Prints the reason and reports failure if it does not.
+     */
+    bool create_budget_allows(const std::string& name, std::size_t footprint) const;
+
+    /**
+     * @brief Implements 'generate': streams a model graph to a snapshot or edge list file without holding it
+     */
+    void cmd_generate(Console::CommandArgs args);
     void cmd_print() const;
+    void cmd_use(Console::CommandArgs args);
+    void cmd_list() const;
+    void cmd_drop(Console::CommandArgs args);
+    void cmd_clone(Console::CommandArgs args);
     void cmd_clear();
     void cmd_cleanup();
     void cmd_exit();
-    void cmd_help(const std::vector<std::string>& args);
+    void cmd_help(Console::CommandArgs args);
     void cmd_history();
-    void cmd_find(const std::vector<std::string>& args) const;
-    void cmd_analyse() const;
+    void cmd_find(Console::CommandArgs args);
+    void cmd_dist(Console::CommandArgs args);
+    void cmd_path(Console::CommandArgs args);
+    void cmd_reach(Console::CommandArgs args);
+    void cmd_landmarks(Console::CommandArgs args);
+    void cmd_labels(Console::CommandArgs args);
+
+    /**
+     * @brief Implements 'dist ~u v' (landmark bounds) and 'dist --alt u v' (exact ALT search)
+     */
+    void landmark_distance(const Graph& graph, int u, int v, bool exact);
+
+    /**
+     * @brief Implements ball (limit in hops) and within (limit in graph distance)
+     */
+    void cmd_neighbourhood(Console::CommandArgs args, bool hops);
+    void cmd_analyse(Console::CommandArgs args);
+    void cmd_snapshot(Console::CommandArgs args);
+    void cmd_centrality(Console::CommandArgs args);
+    void cmd_components() const;
+    void cmd_stats(Console::CommandArgs args) const;
+    void cmd_reorder(Console::CommandArgs args);
+    void cmd_mem(Console::CommandArgs args);
+    void cmd_perf(Console::CommandArgs args);
+    void cmd_serve(Console::CommandArgs args);
+    void cmd_query(Console::CommandArgs args);
+    void cmd_cache(Console::CommandArgs args);
+    void cmd_jobs() const;
+    void cmd_wait(Console::CommandArgs args);
+    void cmd_cancel(Console::CommandArgs args);
 
     static void cmd_smile();
 };
@@ -0,0 +1,63 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief Exception thrown by long-running backend functions when their token is cancelled
+ */
+class OperationCancelled : public std::runtime_error {
+public:
+    OperationCancelled() : std::runtime_error("operation cancelled") {}
+};
+
+/**
+ * @brief Cooperative cancellation flag with progress counters
+ *
+ * Long-running loops (BFS, all-pairs distances) poll the token and throw
+ * OperationCancelled once cancel() was called. They also report progress as
+ * done/total units, which the console shows for background jobs.
+ *
+ * @note All members are lock-free atomics, so cancel() may be called from a
+ *       signal handler or another thread.
+ */
+class CancelToken {
+public:
+    void cancel() noexcept { cancelled.store(true, std::memory_order_relaxed); }
+
+    [[nodiscard]] bool is_cancelled() const noexcept { return cancelled.load(std::memory_order_relaxed); }
+
+    void throw_if_cancelled() const {
+        if (is_cancelled()) throw OperationCancelled();
+    }
+
+    void set_total(const std::size_t units) noexcept {
+        done.store(0, std::memory_order_relaxed);
+        total.store(units, std::memory_order_relaxed);
+    }
+
+    void advance(const std::size_t units = 1) noexcept { done.fetch_add(units, std::memory_order_relaxed); }
+
+    [[nodiscard]] std::size_t get_done() const noexcept { return done.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t get_total() const noexcept { return total.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+    std::atomic<std::size_t> done{0};
+    std::atomic<std::size_t> total{0};
+};
+
+/**
+ * @brief Throws OperationCancelled if token is set and cancelled; no-op for nullptr
+ */
+inline void check_cancelled(const CancelToken* token) {
+    if (token != nullptr) token->throw_if_cancelled();
+}
+
+#endif //CANCELLATION_H
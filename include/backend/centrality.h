@@ -0,0 +1,83 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef CENTRALITY_H
+#define CENTRALITY_H
+
+#include <string_view>
+#include <vector>
+
+#include "cancellation.h"
+
+struct Graph;
+
+/**
+ * @brief Vertex centrality measures computed from shortest paths
+ *
+ * All measures use true shortest paths: BFS on unweighted graphs, Dijkstra
+ * on weighted graphs. Closeness and harmonic centrality use distances *to*
+ * a vertex, which for undirected graphs is the same as distances from it.
+ */
+enum class CentralityMeasure {
+    Closeness,   ///< (r / S) · (r / (n - 1)): r vertices reach v with distance sum S (Wasserman–Faust)
+    Harmonic,    ///< Sum of 1 / d(u, v) over all u that reach v
+    Betweenness  ///< Sum over pairs s, t of the share of shortest s-t paths through v (Brandes)
+};
+
+/**
+ * @brief Parses a measure name ("closeness", "harmonic" or "betweenness")
+ *
+ * @return true if the name is known
+ */
+extern bool parse_centrality_measure(std::string_view name, CentralityMeasure &measure);
+
+/**
+ * @brief Returns the name of a measure, as accepted by parse_centrality_measure
+ */
+extern const char* centrality_measure_name(CentralityMeasure measure);
+
+/**
+ * @brief Tuning of centrality computations
+ */
+struct CentralityOptions {
+    unsigned int threads = 1; ///< Worker threads (0 = hardware concurrency)
+    int samples = 0;          ///< Sources to sample for an approximation; 0 (or >= n) computes exact values
+    unsigned int seed = 0;    ///< Seed of the source sample (0 for random seed based on time)
+};
+
+/**
+ * @brief Computes a centrality measure for every vertex
+ *
+ * Runs one single-source shortest-path search per source. For betweenness
+ * the search also counts shortest paths and accumulates dependencies
+ * backwards in order of decreasing distance (Brandes' algorithm), following
+ * out-edges only, so directed graphs need no reverse adjacency. Sources are
+ * spread over worker threads; every thread adds into its own accumulator
+ * and the accumulators are summed once at the end, so no locking happens
+ * per vertex.
+ *
+ * With options.samples = k < n, only k random sources are searched and the
+ * sums are scaled by n / k: an unbiased estimate of betweenness and harmonic
+ * centrality that costs k searches instead of n.
+ *
+ * @tparam Weight Weighted follows edge weights (Dijkstra), Unweighted counts edges (BFS)
+ * @tparam Direction Undirected halves betweenness, since every pair is seen from both ends
+ * @param graph Graph to analyze
+ * @param measure Measure to compute
+ * @param options Threads and sampling
+ * @param token Optional cancellation token; progress is reported as one unit per source
+ * @return std::vector<double> Centrality per vertex, indexed by user-facing id
+ *
+ * @throws OperationCancelled If token was cancelled during the computation
+ *
+ * @note Time complexity: O(k · m) unweighted, O(k · m log n) weighted, for k sources
+ *
+ * @example
+ * auto betweenness = compute_centrality<Unweighted, Undirected>(graph, CentralityMeasure::Betweenness, {});
+ */
+template <typename Weight, typename Direction>
+std::vector<double> compute_centrality(const Graph &graph, CentralityMeasure measure,
+                                       const CentralityOptions &options, CancelToken *token = nullptr);
+
+#endif //CENTRALITY_H
@@ -0,0 +1,84 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <vector>
+
+struct Graph;
+
+/**
+ * @brief Partition of graph vertices into components
+ *
+ * Component ids are dense (0..count-1) and numbered in order of their
+ * smallest vertex, so output is stable between runs.
+ */
+struct ComponentInfo {
+    std::vector<int> component_of;          ///< Component id of every vertex
+    std::vector<std::vector<int>> members;  ///< Vertices of every component, in increasing order
+    int count = 0;                          ///< Number of components
+};
+
+/**
+ * @brief Finds connected components with union-find
+ *
+ * Edge direction is ignored, so for directed graphs the result is the weakly
+ * connected components. No vertex can reach a vertex outside its component,
+ * which lets all-pairs analysis skip those pairs entirely.
+ *
+ * @param graph Graph to partition
+ * @return ComponentInfo Connected (weakly connected for directed graphs) components
+ *
+ * @note Time complexity: O(n + m·α(n))
+ */
+extern ComponentInfo find_connected_components(const Graph &graph);
+
+/**
+ * @brief Finds strongly connected components with iterative Tarjan's algorithm
+ *
+ * Two vertices are in the same strongly connected component if each is
+ * reachable from the other. For undirected graphs this equals
+ * find_connected_components.
+ *
+ * @param graph Graph to partition
+ * @return ComponentInfo Strongly connected components
+ *
+ * @note Time complexity: O(n + m), no recursion (safe for deep graphs)
+ */
+extern ComponentInfo find_strong_components(const Graph &graph);
+
+/**
+ * @brief Renumbers the vertices of a partition
+ *
+ * @param components Components in the old numbering
+ * @param new_id New id of every old vertex (a permutation of 0..n-1)
+ * @return ComponentInfo The same partition in the new numbering, with component ids
+ *         again ordered by smallest vertex
+ */
+extern ComponentInfo relabel_components(const ComponentInfo &components, const std::vector<int> &new_id);
+
+/**
+ * @brief Radius and diameter of one component
+ */
+struct ComponentSummary {
+    int size;       ///< Number of vertices
+    int radius;     ///< Minimum eccentricity within the component (0 for an isolated vertex)
+    int diameter;   ///< Maximum eccentricity within the component (0 for an isolated vertex)
+};
+
+/**
+ * @brief Computes radius and diameter of every component from vertex eccentricities
+ *
+ * Uses the eccentricities already computed for the whole graph, so no
+ * additional traversal is needed.
+ *
+ * @param components Components of the graph
+ * @param ecc Vertex eccentricities (see compute_eccentricities)
+ * @return std::vector<ComponentSummary> Summary per component id
+ */
+extern std::vector<ComponentSummary> summarize_components(const ComponentInfo &components,
+                                                          const std::vector<int> &ecc);
+
+#endif //COMPONENTS_H
@@ -0,0 +1,117 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef DISTANCE_ENGINES_H
+#define DISTANCE_ENGINES_H
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cancellation.h"
+#include "components.h"
+
+struct Graph;
+struct ReachabilityIndex;
+
+/**
+ * @brief Algorithm used to fill the all-pairs distance matrix
+ *
+ * Bfs and MsBfs sum edge weights along the BFS tree, which is what find and
+ * analyse have always reported. Dijkstra and Floyd compute true weighted
+ * shortest paths. For unweighted graphs all engines give the same matrix.
+ */
+enum class DistanceEngine {
+    Auto,     ///< MsBfs for unweighted graphs with at least 64 vertices, otherwise Bfs
+    Bfs,      ///< One BFS per source
+    MsBfs,    ///< Bit-parallel BFS from 64 sources at once (unweighted graphs only; weighted fall back to Bfs)
+    Dijkstra, ///< One binary-heap Dijkstra per source
+    Floyd     ///< Floyd–Warshall on the adjacency matrix (falls back to Dijkstra without a matrix)
+};
+
+/**
+ * @brief Parses an engine name ("auto", "bfs", "msbfs", "dijkstra" or "floyd")
+ *
+ * @return true if the name is known
+ */
+extern bool parse_distance_engine(std::string_view name, DistanceEngine &engine);
+
+/**
+ * @brief Returns the name of an engine, as accepted by parse_distance_engine
+ */
+extern const char* distance_engine_name(DistanceEngine engine);
+
+/**
+ * @brief Tuning of all-pairs computations
+ */
+struct AnalysisOptions {
+    DistanceEngine engine = DistanceEngine::Auto; ///< Requested engine
+    unsigned int threads = 1;                     ///< Worker threads (0 = hardware concurrency)
+    std::string matrix_file;                      ///< If set, analyse_graph keeps the matrix in this memory-mapped file instead of RAM
+    bool keep_matrix_file = true;                 ///< Whether matrix_file stays on disk once the result is dropped
+    const ReachabilityIndex* reachability = nullptr; ///< If set, searches stop once every reachable vertex is labelled
+};
+
+/**
+ * @brief Receives one finished row of the distance matrix
+ *
+ * Called once per source vertex with its n distances in stored-id order
+ * (-1 = unreachable). Calls come from worker threads, concurrently but never
+ * twice for the same source; the row is only valid during the call.
+ */
+using DistanceRowSink = std::function<void(int source, std::span<const int> row)>;
+
+/**
+ * @brief Returns the engine that will actually run for a graph
+ *
+ * Resolves Auto and the fallbacks described in DistanceEngine.
+ *
+ * @tparam Weight Weighted or Unweighted
+ */
+template <typename Weight>
+DistanceEngine select_distance_engine(const Graph &graph, DistanceEngine requested);
+
+/**
+ * @brief Computes all-pairs distances row by row and streams every row to a sink
+ *
+ * Nothing of size n² is held in memory, which lets callers write rows straight
+ * to disk (see DistanceMatrixFile). Floyd needs the whole matrix, so it is
+ * replaced by Dijkstra here, which gives the same distances.
+ *
+ * @tparam Weight Weighted sums edge weights, Unweighted counts edges
+ * @param graph Graph to analyze
+ * @param components Result of find_connected_components for this graph
+ * @param options Engine and thread count
+ * @param sink Receives every row exactly once
+ * @param token Optional cancellation token; progress is reported as one unit per source vertex
+ *
+ * @throws OperationCancelled If token was cancelled during the computation
+ */
+template <typename Weight>
+void compute_distance_rows(const Graph &graph, const ComponentInfo &components, const AnalysisOptions &options,
+                           const DistanceRowSink &sink, CancelToken *token = nullptr);
+
+/**
+ * @brief Builds the all-pairs distance matrix with the selected engine
+ *
+ * Sources are processed inside their component only; entries between
+ * components stay -1. Work is split over options.threads threads, each with
+ * its own workspace, and every source row is written by exactly one thread.
+ *
+ * @tparam Weight Weighted sums edge weights, Unweighted counts edges
+ * @param graph Graph to analyze
+ * @param components Result of find_connected_components for this graph
+ * @param options Engine and thread count
+ * @param token Optional cancellation token; progress is reported as one unit per source vertex
+ * @return std::vector<std::vector<int>> n×n matrix indexed by stored ids (-1 = unreachable)
+ *
+ * @throws OperationCancelled If token was cancelled during the computation
+ */
+template <typename Weight>
+std::vector<std::vector<int>> compute_distance_matrix(const Graph &graph, const ComponentInfo &components,
+                                                      const AnalysisOptions &options, CancelToken *token = nullptr);
+
+#endif //DISTANCE_ENGINES_H
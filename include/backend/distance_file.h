@@ -0,0 +1,143 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef DISTANCE_FILE_H
+#define DISTANCE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+/**
+ * @brief n×n distance matrix stored in a memory-mapped file
+ *
+ * Used when the matrix does not fit in memory: rows are written into the
+ * mapping as they are computed and read back through it, so the operating
+ * system pages them to and from disk. The file starts with a 16-byte header
+ * (magic "GDM1" and n) followed by the rows as 32-bit ints in native byte
+ * order, -1 meaning unreachable.
+ *
+ * @example
+ * auto file = DistanceMatrixFile::create("dist.gdm", graph.n, true);
+ * std::ranges::copy(row, file->mutable_row(0).begin());
+ * file->sync();
+ * file->commit();
+ * auto same = DistanceMatrixFile::open("dist.gdm");
+ * int d = same->row(0)[5];
+ */
+class DistanceMatrixFile {
+public:
+    /**
+     * @brief Creates (or truncates) a file for an n×n matrix and maps it for writing
+     *
+     * @param path File to create; rows are written to a unique temporary file next to it until commit()
+     * @param n Matrix dimension
+     * @param keep Whether the file stays on disk after the object is destroyed (only once committed)
+     * @return std::shared_ptr<DistanceMatrixFile> Mapped file; rows are undefined until written
+     *
+     * @throws std::runtime_error If the file cannot be created, sized or mapped
+     */
+    static std::shared_ptr<DistanceMatrixFile> create(const std::string& path, int n, bool keep);
+
+    /**
+     * @brief Maps an existing matrix file read-only
+     *
+     * @throws std::runtime_error If the file cannot be opened or is not a distance matrix file
+     */
+    static std::shared_ptr<DistanceMatrixFile> open(const std::string& path);
+
+    /**
+     * @brief Maps read-only an n×n matrix stored inside a larger file, such as a snapshot
+     *
+     * @param path File containing the matrix
+     * @param offset Byte offset of row 0 within the file
+     * @param n Matrix dimension
+     *
+     * @throws std::runtime_error If the file cannot be opened or is too short for the matrix
+     */
+    static std::shared_ptr<DistanceMatrixFile> open_embedded(const std::string& path, std::size_t offset, int n);
+
+    ~DistanceMatrixFile();
+    DistanceMatrixFile(const DistanceMatrixFile&) = delete;
+    DistanceMatrixFile& operator=(const DistanceMatrixFile&) = delete;
+
+    [[nodiscard]] int size() const { return n; }
+    [[nodiscard]] const std::string& path() const { return file_path; }
+
+    /**
+     * @brief Moves a complete matrix created with keep = true to the path it was created for
+     *
+     * create() writes to a unique temporary file next to path, so neither a
+     * failed write nor a reader still mapping an earlier file at path is
+     * affected; commit() renames it over path once the rows are synced. A
+     * file created with keep = false keeps its temporary name, so removing it
+     * on destruction can never hit another file.
+     *
+     * @throws std::runtime_error If the file cannot be renamed
+     */
+    void commit();
+
+    /**
+     * @brief Returns the bytes the file takes on disk for an n×n matrix
+     */
+    static std::size_t file_bytes(int n);
+
+    /**
+     * @brief Returns row v, read through the mapping
+     */
+    [[nodiscard]] std::span<const int> row(int v) const;
+
+    /**
+     * @brief Returns row v for writing
+     *
+     * Different rows may be written from different threads at the same time.
+     *
+     * @throws std::logic_error If the file was opened read-only
+     */
+    std::span<int> mutable_row(int v);
+
+    /**
+     * @brief Writes dirty pages of rows [first, first + count) back to disk without waiting
+     *
+     * Lets the writer stream finished blocks out instead of piling up dirty pages.
+     */
+    void flush_rows(int first, int count);
+
+    /**
+     * @brief Writes all dirty pages back to disk and waits for completion
+     */
+    void sync();
+
+    /**
+     * @brief Hints that rows will be read in order, e.g. before printing the whole matrix
+     */
+    void advise_sequential() const;
+
+private:
+    DistanceMatrixFile() = default;
+
+    std::string file_path;
+    int n = 0;
+    bool writable = false;
+    bool keep_file = true;
+    std::string target_path;     ///< Path the file is renamed to by commit(); empty once committed
+    std::byte* mapping = nullptr;
+    std::size_t mapping_bytes = 0;
+    std::size_t rows_offset = 0; ///< Byte offset of row 0 within the mapping
+
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+
+    void map(std::size_t bytes);
+    std::size_t open_read_only();
+    [[nodiscard]] int* rows() const;
+};
+
+#endif //DISTANCE_FILE_H
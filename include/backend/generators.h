@@ -0,0 +1,186 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "graph_gen.h"
+
+/**
+ * @brief Random graph models besides the Erdős–Rényi model of create_graph
+ */
+enum class GraphModel {
+    Rmat,           ///< R-MAT / Kronecker: skewed, power-law-like degrees, small diameter
+    BarabasiAlbert, ///< Preferential attachment: scale-free degrees
+    WattsStrogatz,  ///< Small world: ring lattice with randomly rewired edges
+    Grid            ///< 2-D grid: uniform degree, diameter rows + cols - 2
+};
+
+/**
+ * @brief Model and parameters of a generated graph
+ *
+ * Only the fields of the selected model are used.
+ */
+struct ModelSpec {
+    GraphModel model = GraphModel::Rmat;
+    unsigned int seed = 0;      ///< Seed (0 for random seed based on time)
+
+    int scale = 10;             ///< R-MAT: n = 2^scale
+    int edge_factor = 16;       ///< R-MAT: m = edge_factor * n
+    double a = 0.57;            ///< R-MAT: probability of the top-left quadrant
+    double b = 0.19;            ///< R-MAT: probability of the top-right quadrant
+    double c = 0.19;            ///< R-MAT: probability of the bottom-left quadrant
+
+    int attach = 4;             ///< Barabási–Albert: edges added per new vertex
+
+    int neighbours = 4;         ///< Watts–Strogatz: lattice degree k (even)
+    double rewire = 0.1;        ///< Watts–Strogatz: rewiring probability beta
+
+    int rows = 32;              ///< Grid: number of rows
+    int cols = 32;              ///< Grid: number of columns
+
+    int n = 0;                  ///< Barabási–Albert and Watts–Strogatz: number of vertices
+};
+
+/// Graphs with at most this many vertices also get an adjacency matrix (used by 'print')
+inline constexpr int default_dense_matrix_limit = 2048;
+
+/**
+ * @brief Parses a model name ("rmat", "ba", "ws" or "grid")
+ *
+ * @return true if the name is known
+ */
+extern bool parse_graph_model(std::string_view name, GraphModel &model);
+
+/**
+ * @brief Returns the short name of a model, as accepted by parse_graph_model
+ */
+extern const char* graph_model_name(GraphModel model);
+
+/**
+ * @brief Checks model parameters
+ *
+ * @return Empty string if valid, otherwise a description of the problem
+ */
+extern std::string validate_model_spec(const ModelSpec &spec);
+
+/**
+ * @brief Returns the number of vertices the model produces
+ */
+extern int model_vertex_count(const ModelSpec &spec);
+
+/**
+ * @brief Returns the number of edges the model draws (before dropping loops and duplicates)
+ */
+extern std::size_t model_edge_count(const ModelSpec &spec);
+
+/**
+ * @brief Estimates peak memory of generate_model_graph
+ *
+ * Counts the temporary edge buffer, the adjacency list and, for small graphs,
+ * the adjacency matrix.
+ *
+ * @param spec Model and parameters
+ * @param weighted Whether weights are stored
+ * @param dense_matrix_limit See generate_model_graph
+ * @return Estimated size in bytes
+ */
+extern std::size_t estimate_model_footprint(const ModelSpec &spec, bool weighted,
+                                            int dense_matrix_limit = default_dense_matrix_limit);
+
+/**
+ * @brief Generates a graph of the given model in O(n + m) time
+ *
+ * Every edge is drawn from its own counter-based random stream derived from
+ * the seed and the edge index, so edges are generated in parallel blocks and
+ * the result does not depend on the number of threads. Self-loops and
+ * duplicate edges are dropped (a duplicate keeps its smallest weight).
+ *
+ * For Directed, R-MAT, Barabási–Albert and Watts–Strogatz edges keep the
+ * orientation they were drawn with (R-MAT source to target, new vertex to
+ * older vertex, lattice vertex to its clockwise neighbour); grid cells link
+ * to their neighbours in both directions.
+ *
+ * @tparam Weight Weighted (weights 1-10) or Unweighted
+ * @tparam Direction Directed or Undirected
+ * @param spec Model and parameters (must pass validate_model_spec)
+ * @param dense_matrix_limit Build the adjacency matrix only if n does not exceed this; otherwise it is nullptr
+ * @param threads Number of generator threads (0 = hardware concurrency)
+ * @return Graph Generated graph with sorted adjacency lists; must be freed with delete_graph
+ *
+ * @throws std::invalid_argument If spec is invalid
+ * @throws std::bad_alloc If unable to allocate memory
+ *
+ * @note Barabási–Albert uses the communication-free formulation by Sanders and Schulz,
+ *       so every edge is resolved independently of the others
+ */
+template <typename Weight, typename Direction>
+Graph generate_model_graph(const ModelSpec &spec, int dense_matrix_limit = default_dense_matrix_limit,
+                           unsigned int threads = 0);
+
+/**
+ * @brief Consecutive adjacency rows of a generated graph, in CSR form
+ *
+ * Rows first_row .. first_row + rows() - 1; their neighbours are sorted and
+ * duplicate-free, exactly as in the graph generate_model_graph returns.
+ */
+struct RowBlock {
+    int first_row = 0;
+    std::vector<std::size_t> offsets{0}; ///< rows() + 1 offsets into targets, starting at 0
+    std::vector<int> targets;
+    std::vector<int> weights;            ///< Weight of every target; empty for Unweighted
+
+    [[nodiscard]] int rows() const { return static_cast<int>(offsets.size()) - 1; }
+};
+
+/**
+ * @brief Generates a model graph block of rows at a time, without ever holding the whole graph
+ *
+ * Unless the whole graph fits into memory_limit, a first pass over all edges
+ * counts the adjacency entries of every group of rows, and the rows are cut
+ * into blocks of about memory_limit bytes. For
+ * every block all edges are drawn again and only those with an endpoint in
+ * the block are kept. Since every edge comes from its own counter-based
+ * random stream, each pass sees the same edges, and the rows passed to sink
+ * are exactly those of generate_model_graph with the same seed.
+ *
+ * @tparam Weight Weighted (weights 1-10) or Unweighted
+ * @tparam Direction Directed or Undirected
+ * @param spec Model and parameters (must pass validate_model_spec; seed 0 is replaced by a time-based one)
+ * @param memory_limit Target peak memory of one block in bytes; a block holds at least one group of rows
+ * @param threads Number of generator threads (0 = hardware concurrency)
+ * @param sink Called with every block, in increasing row order
+ * @param token Optional cancellation token; progress is reported as one unit per block
+ * @return Number of blocks, i.e. passes over the edges after the counting pass
+ *
+ * @throws std::invalid_argument If spec is invalid
+ * @throws OperationCancelled If token was cancelled between blocks
+ *
+ * @note Time complexity: O(m) per block, so memory is traded for time; memory: O(memory_limit + n / 65536)
+ */
+template <typename Weight, typename Direction>
+int stream_model_graph(const ModelSpec &spec, std::size_t memory_limit, unsigned int threads,
+                       const std::function<void(const RowBlock&)> &sink, CancelToken *token = nullptr);
+
+/**
+ * @brief Writes the edges of a block as text, one "u v" (or "u v weight") line per edge
+ *
+ * Undirected edges are written once, from the smaller endpoint. Lines are
+ * formatted in parallel and written in row order.
+ *
+ * @param out Stream to write to
+ * @param block Rows to write
+ * @param directed Whether every entry is an edge of its own
+ * @param threads Number of formatting threads (0 = hardware concurrency)
+ */
+extern void write_edge_list(std::ostream &out, const RowBlock &block, bool directed, unsigned int threads = 0);
+
+#endif //GENERATORS_H
@@ -5,22 +5,54 @@
 #ifndef GRAPH_GEN_H
 #define GRAPH_GEN_H
 
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <vector>
 
+#include "cancellation.h"
+#include "components.h"
+#include "distance_engines.h"
+#include "distance_file.h"
+#include "graph_policies.h"
+#include "graph_storage.h"
+#include "memory_tracker.h"
+
 /**
  * @brief Structure representing a graph in two forms: adjacency matrix and adjacency list
  *
  * The graph is stored simultaneously as an adjacency matrix (for efficient edge access)
- * and an adjacency list (for efficient neighbor traversal).
+ * and an adjacency list (for efficient neighbor traversal). The list is kept in
+ * compact CSR form whose id and weight types are chosen from n and the weight
+ * policy at creation (see graph_storage.h).
+ *
+ * Storage may use a different vertex numbering than the user sees (see reorder.h).
+ * original_id maps a stored vertex to the id the user knows it by, internal_id maps back;
+ * both are empty while the numbering is the one the graph was created with.
  */
 struct Graph {
-    int** adj_matrix;                                       ///< 2D array representing adjacency matrix
-    std::vector<std::vector<std::pair<int, int>>> adj_list; ///< Adjacency list with pairs (vertex, weight)
+    int** adj_matrix;                                       ///< 2D array representing adjacency matrix (nullptr for large generated graphs)
+    AdjacencyStorage adj_list;                              ///< Adjacency list; neighbours sorted by user-facing id
     int n;                                                  ///< Number of vertices in the graph
+    std::vector<int> original_id;                           ///< User-facing id of every stored vertex (empty = identity)
+    std::vector<int> internal_id;                           ///< Stored vertex of every user-facing id (empty = identity)
 };
 
+/**
+ * @brief Returns the user-facing id of a stored vertex
+ */
+inline int original_vertex(const Graph &graph, const int v) {
+    return graph.original_id.empty() ? v : graph.original_id[v];
+}
+
+/**
+ * @brief Returns the stored vertex of a user-facing id
+ */
+inline int internal_vertex(const Graph &graph, const int v) {
+    return graph.internal_id.empty() ? v : graph.internal_id[v];
+}
+
 /**
  * @brief Creates a random graph with specified parameters
  *
@@ -30,9 +62,9 @@ struct Graph {
  * @param n Number of vertices in the graph (must be > 0)
  * @param edgeProb Probability of creating an edge between two distinct vertices (0.0 - 1.0)
  * @param loopProb Probability of creating a loop (edge from vertex to itself) (0.0 - 1.0)
+ * @tparam Weight Weighted (weights 1-10) or Unweighted (all weights = 1)
+ * @tparam Direction Directed or Undirected
  * @param seed Seed for random number generator (0 for random seed based on time)
- * @param weighted If true, creates a weighted graph (weights 1-10), else unweighted (all weights = 1)
- * @param directed If true, creates a directed graph, else undirected
  * @return Graph Generated graph
  *
  * @throws std::bad_alloc If unable to allocate memory for adjacency matrix
@@ -41,11 +73,75 @@ struct Graph {
  * @note For weighted graphs, weights are randomly generated in range 1-10
  *
  * @example
- * Graph g1 = create_graph(10, 0.3, 0.1, 123, false, false); // Unweighted undirected
- * Graph g2 = create_graph(8, 0.5, 0.2, 456, true, true);    // Weighted directed
+ * Graph g1 = create_graph<Unweighted, Undirected>(10, 0.3, 0.1, 123);
+ * Graph g2 = create_graph<Weighted, Directed>(8, 0.5, 0.2, 456);
+ */
+template <typename Weight, typename Direction>
+Graph create_graph(int n, double edgeProb = 0.4, double loopProb = 0.15, unsigned int seed = 0);
+
+/**
+ * @brief Creates a deep copy of a graph
+ *
+ * @param graph Graph to copy
+ * @return Graph Independent copy; must be freed with delete_graph
+ *
+ * @throws std::bad_alloc If unable to allocate memory for the copy
+ */
+extern Graph copy_graph(const Graph &graph);
+
+/**
+ * @brief Moves a graph into a shared pointer that frees it with delete_graph
+ *
+ * Lets several owners (the console, background jobs) hold the same graph;
+ * memory is released when the last owner drops it.
+ *
+ * @param graph Graph to take ownership of
+ * @return std::shared_ptr<Graph> Shared owner of the graph
+ */
+extern std::shared_ptr<Graph> make_shared_graph(Graph graph);
+
+/**
+ * @brief Returns number of bytes occupied by the adjacency matrix of the graph
+ *
+ * @param graph Graph to measure
+ * @return Size of row storage plus row pointer array, or 0 if the matrix is not allocated
+ */
+extern std::size_t graph_matrix_bytes(const Graph &graph);
+
+/**
+ * @brief Returns number of bytes occupied by the adjacency list of the graph
+ *
+ * Counts reserved capacity, not only used entries, since that is what the allocator holds.
+ *
+ * @param graph Graph to measure
+ * @return Size of the offset, target and weight arrays
  */
-extern Graph create_graph(int n, double edgeProb = 0.4, double loopProb = 0.15,
-                         unsigned int seed = 0, bool weighted = false, bool directed = false);
+extern std::size_t graph_list_bytes(const Graph &graph);
+
+/**
+ * @brief Computes an order-independent checksum of a graph's edges in O(n + m)
+ *
+ * Mixes the user-facing endpoints and weight of every edge, so the same
+ * graph gives the same value regardless of vertex reordering. Used to check
+ * that saved indexes and snapshots belong to a graph.
+ */
+extern std::uint64_t graph_fingerprint(const Graph &graph);
+
+/**
+ * @brief Accumulates graph_fingerprint one edge at a time, for graphs that are never held whole
+ */
+class FingerprintBuilder {
+public:
+    explicit FingerprintBuilder(int n);
+
+    /// Adds the edge from -> to between user-facing vertices (weight 1 if unweighted)
+    void add(int from, int to, int weight);
+
+    [[nodiscard]] std::uint64_t value() const { return sum; }
+
+private:
+    std::uint64_t sum;
+};
 
 /**
  * @brief Prints a matrix in formatted form
@@ -90,17 +186,17 @@ extern void delete_graph(Graph& graph, int n);
  *
  * Displays for each vertex its list of neighbors in format (vertex, weight).
  *
- * @param list Adjacency list to print
+ * @param graph Graph whose adjacency list to print
  * @param name Title for list output
  *
  * @example
- * print_list(graph.adj_list, "Adjacency List");
+ * print_list(graph, "Adjacency List");
  * // Output:
  * // 0: (1, 3) (2, 1)
  * // 1: (0, 3) (3, 2)
  * // ...
  */
-extern void print_list(const std::vector<std::vector<std::pair<int, int>>> &list, const char *name);
+extern void print_list(const Graph &graph, const char *name);
 
 // ============================================================================
 // GRAPH ANALYSIS FUNCTIONS BASED ON BFS
@@ -112,21 +208,32 @@ extern void print_list(const std::vector<std::vector<std::pair<int, int>>> &list
  * Uses Breadth-First Search (BFS) algorithm to compute shortest distances
  * from start vertex to all reachable vertices.
  *
+ * Vertex ids of the argument, the traversal order and the result are
+ * user-facing ids, even if the graph has been reordered.
+ *
+ * @tparam Weight Weighted sums edge weights, Unweighted counts edges
  * @param graph Graph to analyze
  * @param start_v Starting vertex (must be in range [0, graph.n-1])
+ * @param order_out Stream for traversal order, or nullptr to suppress it
+ * @param token Optional cancellation token, polled once per visited vertex
+ * @param parents If set, receives the BFS tree: parents[i] is the vertex i was reached from,
+ *                -1 for start_v and unreachable vertices
  * @return std::vector<int> Vector of distances where distances[i] = distance to vertex i,
  *                         or -1 if vertex i is unreachable from start_v
  *
  * @throws std::out_of_range If start_v is outside valid range
+ * @throws OperationCancelled If token was cancelled during the search
  *
  * @note For weighted graphs, considers edge weights when computing distances
  * @note For directed graphs, respects edge direction
  *
  * @example
- * auto dist = find_distances(graph, 0);
+ * auto dist = find_distances<Unweighted>(graph, 0);
  * // dist[3] contains distance from vertex 0 to vertex 3
  */
-extern std::vector<int> find_distances(const Graph &graph, int start_v);
+template <typename Weight>
+std::vector<int> find_distances(const Graph &graph, int start_v, std::ostream *order_out = &std::cout,
+                                const CancelToken *token = nullptr, std::vector<int> *parents = nullptr);
 
 /**
  * @brief Implementation of BFS algorithm for distance computation (BFSD)
@@ -134,17 +241,98 @@ extern std::vector<int> find_distances(const Graph &graph, int start_v);
  * Helper function that performs breadth-first search from given vertex
  * and fills the distance vector DIST.
  *
+ * @tparam Weight Weighted sums edge weights, Unweighted counts edges
  * @param graph Graph to traverse
- * @param start_v Starting vertex for traversal
- * @param DIST Distance vector (filled by function). Must be initialized with
- *             size graph.n and values -1
+ * @param start_v Starting vertex for traversal (stored id)
+ * @param DIST Distance vector indexed by stored ids (filled by function). Must be
+ *             initialized with size graph.n and values -1
+ * @param order_out Stream that receives the traversal order (user-facing ids), or nullptr to suppress it
+ * @param token Optional cancellation token, polled once per visited vertex
+ * @param PARENT If set, filled with the stored id each vertex was reached from (-1 for start_v
+ *               and unreachable vertices); resized to graph.n by the function
+ *
+ * @throws OperationCancelled If token was cancelled during the search
  *
  * @note Modifies DIST vector, setting distances to reachable vertices
- * @note Does not print traversal order (unlike some educational BFS implementations)
  *
  * @see find_distances
  */
-extern void BFSD(const Graph &graph, int start_v, std::vector<int> &DIST);
+template <typename Weight>
+void BFSD(const Graph &graph, int start_v, std::vector<int> &DIST, std::ostream *order_out = &std::cout,
+          const CancelToken *token = nullptr, std::vector<int> *PARENT = nullptr);
+
+/**
+ * @brief Prints distances together with the BFS tree they were found along
+ *
+ * @param DIST Distance vector, as returned by find_distances
+ * @param PARENT Parent of every vertex, as filled by find_distances
+ * @param start_v Root of the tree (used only for header)
+ * @param out Output stream
+ *
+ * @example
+ * print_distance_tree(distances, parents, 0);
+ * // Output:
+ * // BFS tree from vertex 0:
+ * // Vertex 0: 0 (root)
+ * // Vertex 1: 3 (parent 4)
+ * // Vertex 2: unreachable
+ */
+extern void print_distance_tree(const std::vector<int> &DIST, const std::vector<int> &PARENT, int start_v,
+                                std::ostream &out = std::cout);
+
+/**
+ * @brief Distance from every vertex to its nearest source, with that source
+ */
+struct NearestSources {
+    std::vector<int> distances; ///< Distance per vertex (user-facing ids), -1 if no source reaches it
+    std::vector<int> sources;   ///< Nearest source per vertex (user-facing ids), -1 if no source reaches it
+};
+
+/**
+ * @brief Finds the nearest of several sources for every vertex in one search
+ *
+ * All sources are seeded at distance 0, so one BFS (unweighted) or one
+ * Dijkstra (weighted) labels every vertex with the distance to its nearest
+ * source and the source the label came from, in O(n + m) instead of one
+ * search per source. Ties go to the source listed first.
+ *
+ * @tparam Weight Weighted computes shortest weighted distances, Unweighted counts edges
+ * @param graph Graph to traverse
+ * @param sources Source vertices (user-facing ids); duplicates are ignored
+ * @param token Optional cancellation token, polled once per visited vertex
+ * @return NearestSources Distances and nearest sources indexed by user-facing id
+ *
+ * @throws std::out_of_range If a source is outside valid range
+ * @throws std::invalid_argument If sources is empty
+ * @throws OperationCancelled If token was cancelled during the search
+ *
+ * @note For directed graphs, distances are measured from the sources along edge direction
+ * @note For weighted graphs the distances are true shortest paths, unlike the
+ *       BFS-tree distances of find_distances
+ *
+ * @example
+ * auto nearest = find_nearest_sources<Unweighted>(graph, {0, 7});
+ * // nearest.distances[3] is the distance from vertex 3's closer source, nearest.sources[3] is 0 or 7
+ */
+template <typename Weight>
+NearestSources find_nearest_sources(const Graph &graph, const std::vector<int> &sources,
+                                    const CancelToken *token = nullptr);
+
+/**
+ * @brief Prints the nearest source and its distance for every vertex
+ *
+ * @param nearest Result of find_nearest_sources
+ * @param out Output stream
+ *
+ * @example
+ * print_nearest_sources(nearest);
+ * // Output:
+ * // Nearest sources:
+ * // Vertex 0: 0 (source 0)
+ * // Vertex 1: 2 (source 7)
+ * // Vertex 2: unreachable
+ */
+extern void print_nearest_sources(const NearestSources &nearest, std::ostream &out = std::cout);
 
 /**
  * @brief Prints distance vector in readable format
@@ -154,6 +342,7 @@ extern void BFSD(const Graph &graph, int start_v, std::vector<int> &DIST);
  *
  * @param DIST Distance vector to print
  * @param start_v Starting vertex (used only for header)
+ * @param out Output stream
  *
  * @example
  * print_distances(distances, 0);
@@ -163,7 +352,7 @@ extern void BFSD(const Graph &graph, int start_v, std::vector<int> &DIST);
  * // Vertex 1: 3
  * // Vertex 2: unreachable
  */
-extern void print_distances(const std::vector<int> &DIST, int start_v);
+extern void print_distances(const std::vector<int> &DIST, int start_v, std::ostream &out = std::cout);
 
 /**
  * @brief Builds distance matrix between all vertex pairs
@@ -171,18 +360,43 @@ extern void print_distances(const std::vector<int> &DIST, int start_v);
  * Computes shortest distances between all pairs of vertices in the graph
  * by repeatedly calling BFS from each vertex.
  *
+ * @tparam Weight Weighted sums edge weights, Unweighted counts edges
  * @param graph Graph to analyze
+ * @param token Optional cancellation token; progress is reported as one unit per source vertex
  * @return std::vector<std::vector<int>> n×n matrix where dist_matrix[i][j] contains
  *         distance from vertex i to vertex j, or -1 if j is unreachable from i
  *
+ * @throws OperationCancelled If token was cancelled during the computation
+ *
  * @note Time complexity: O(n × (n + m)) where m is number of edges
  * @note For large graphs, may be inefficient; consider Floyd-Warshall for dense graphs
+ * @note Rows and columns are indexed by stored ids; analyse_graph maps them back to user-facing ids
  *
  * @example
- * auto dist_matrix = build_distance_matrix(graph);
+ * auto dist_matrix = build_distance_matrix<Unweighted>(graph);
  * // dist_matrix[2][4] contains distance from vertex 2 to vertex 4
  */
-extern std::vector<std::vector<int>> build_distance_matrix(const Graph &graph);
+template <typename Weight>
+std::vector<std::vector<int>> build_distance_matrix(const Graph &graph, CancelToken *token = nullptr);
+
+/**
+ * @brief Builds distance matrix using precomputed connected components
+ *
+ * Each BFS runs inside the component of its source with a workspace sized to
+ * that component, and entries for vertices of other components are left at -1
+ * without being visited. Runs the single-threaded Bfs engine of
+ * compute_distance_matrix.
+ *
+ * @param graph Graph to analyze
+ * @param components Result of find_connected_components for this graph
+ * @param token Optional cancellation token; progress is reported as one unit per source vertex
+ * @return std::vector<std::vector<int>> n×n distance matrix, same as build_distance_matrix(graph)
+ *
+ * @throws OperationCancelled If token was cancelled during the computation
+ */
+template <typename Weight>
+std::vector<std::vector<int>> build_distance_matrix(const Graph &graph, const ComponentInfo &components,
+                                                    CancelToken *token = nullptr);
 
 /**
  * @brief Computes eccentricities of all graph vertices
@@ -265,6 +479,46 @@ extern std::vector<int> find_central_vertices(const std::vector<int> &ecc, int r
  */
 extern std::vector<int> find_peripheral_vertices(const std::vector<int> &ecc, int diameter);
 
+/**
+ * @brief Complete result of all-pairs analysis of a graph
+ */
+struct AnalysisResult {
+    std::vector<std::vector<int>> dist_matrix; ///< Distances between all vertex pairs (-1 = unreachable); empty if dist_file is set
+    std::shared_ptr<const DistanceMatrixFile> dist_file; ///< Out-of-core analysis: distances in a mapped file instead of dist_matrix
+    std::vector<int> eccentricities;           ///< Eccentricity of every vertex (-1 = isolated)
+    int radius;                                ///< Graph radius (-1 if disconnected)
+    int diameter;                              ///< Graph diameter (-1 if disconnected)
+    std::vector<int> central;                  ///< Vertices with eccentricity == radius
+    std::vector<int> peripheral;               ///< Vertices with eccentricity == diameter
+    ComponentInfo components;                  ///< Connected (weakly for directed graphs) components
+    std::vector<ComponentSummary> component_summary; ///< Radius and diameter per component
+    TrackedBytes tracked;                      ///< Accounts dist_matrix as MemoryCategory::DistanceMatrix
+    bool shortest_paths = false;               ///< Distances are shortest paths (unweighted graph, or Dijkstra/Floyd engine)
+};
+
+/**
+ * @brief Runs the full analysis pipeline: distance matrix, eccentricities, radius,
+ *        diameter, central and peripheral vertices
+ *
+ * All vertex ids in the result are user-facing ids, even if the graph has been reordered.
+ *
+ * If options.matrix_file is set, rows are streamed into that memory-mapped
+ * file as they are computed (see compute_distance_rows) and the result holds
+ * dist_file instead of dist_matrix, so RAM use stays O(n) per thread and only
+ * disk space grows with n². All other fields are identical in both modes.
+ *
+ * @tparam Weight Weighted sums edge weights, Unweighted counts edges
+ * @param graph Graph to analyze
+ * @param token Optional cancellation token (see build_distance_matrix)
+ * @param options Distance engine, thread count and optional matrix file (see compute_distance_matrix)
+ * @return AnalysisResult All computed artifacts
+ *
+ * @throws OperationCancelled If token was cancelled during the computation
+ * @throws std::runtime_error If the matrix file cannot be created
+ */
+template <typename Weight>
+AnalysisResult analyse_graph(const Graph &graph, CancelToken *token = nullptr, const AnalysisOptions &options = {});
+
 /**
  * @brief Prints distance matrix in formatted form
  *
@@ -272,8 +526,43 @@ extern std::vector<int> find_peripheral_vertices(const std::vector<int> &ecc, in
  * notation "∞" for unreachable vertices (-1).
  *
  * @param dist_matrix Distance matrix to print
+ * @param out Output stream
  *
  * @see build_distance_matrix
  */
-extern void print_distance_matrix(const std::vector<std::vector<int>> &dist_matrix);
+extern void print_distance_matrix(const std::vector<std::vector<int>> &dist_matrix, std::ostream &out = std::cout);
+
+/**
+ * @brief Prints a distance matrix kept in a file, reading rows in order through the mapping
+ */
+extern void print_distance_matrix(const DistanceMatrixFile &dist_file, std::ostream &out = std::cout);
+
+/**
+ * @brief Returns distances from vertex v of an analysis, whether kept in memory or in a file
+ *
+ * @param result Analysis result
+ * @param v User-facing vertex id (0 <= v < number of vertices)
+ * @return std::span<const int> Row of the distance matrix, valid as long as result
+ */
+extern std::span<const int> distance_row(const AnalysisResult &result, int v);
+
+/**
+ * @brief Reconstructs a shortest path from an analysis without searching the graph
+ *
+ * The distance matrix already encodes every first hop: from x, the next
+ * vertex towards v is a neighbour y with dist(x, v) = w(x, y) + dist(y, v).
+ * Walking these hops costs O(path length × degree), so repeated path
+ * queries on an analysed graph need no traversal and no predecessor
+ * storage beyond the matrix. Ties go to the neighbour with the smallest id.
+ *
+ * @param graph Graph the analysis was computed for
+ * @param result Analysis with result.shortest_paths set
+ * @param u Start vertex (user-facing id)
+ * @param v End vertex (user-facing id)
+ * @return std::vector<int> Vertices of the path from u to v (user-facing ids), empty if v is unreachable
+ *
+ * @throws std::logic_error If the distances of result are not shortest paths
+ * @throws std::out_of_range If u or v is outside valid range
+ */
+extern std::vector<int> path_from_distances(const Graph &graph, const AnalysisResult &result, int u, int v);
 #endif //GRAPH_GEN_H
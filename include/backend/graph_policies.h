@@ -0,0 +1,31 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef GRAPH_POLICIES_H
+#define GRAPH_POLICIES_H
+
+/**
+ * @brief Compile-time graph kind policies
+ *
+ * Generator and traversal kernels are templates over these types, so every
+ * combination is compiled into its own branch-free variant. Kernels are
+ * explicitly instantiated for all policies in graph_gen.cpp; the console
+ * picks a variant once per command from its runtime flags.
+ *
+ * @example
+ * Graph g = create_graph<Weighted, Undirected>(10, 0.3, 0.1, 123);
+ * auto dist = find_distances<Weighted>(g, 0);
+ */
+
+/// Edges carry weights 1-10 that add up along paths
+struct Weighted { static constexpr bool value = true; };
+/// Every edge has weight 1; kernels never read the stored weights
+struct Unweighted { static constexpr bool value = false; };
+
+/// Edges are one-way
+struct Directed { static constexpr bool value = true; };
+/// Every edge is stored in both directions; the adjacency matrix is symmetric
+struct Undirected { static constexpr bool value = false; };
+
+#endif //GRAPH_POLICIES_H
@@ -0,0 +1,74 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef GRAPH_STATS_H
+#define GRAPH_STATS_H
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+struct Graph;
+
+/**
+ * @brief Minimum, maximum, mean and histogram of one degree kind
+ *
+ * histogram[0] counts vertices of degree 0, histogram[k] for k > 0 counts
+ * degrees in [2^(k-1), 2^k), so even skewed degree distributions fit in a
+ * few dozen buckets.
+ */
+struct DegreeSummary {
+    std::size_t min = 0;
+    std::size_t max = 0;
+    double mean = 0.0;
+    std::vector<std::size_t> histogram;
+};
+
+/**
+ * @brief Size and degree statistics of a graph
+ *
+ * Degrees count adjacency entries, so a loop adds one to the degree of its vertex.
+ */
+struct GraphStats {
+    int vertices = 0;
+    std::size_t edges = 0;       ///< Edges, each undirected edge counted once, loops included
+    std::size_t loops = 0;       ///< Edges from a vertex to itself
+    double density = 0.0;        ///< Non-loop edges divided by the possible ones (n(n-1), or n(n-1)/2 undirected)
+    bool directed = false;
+    bool weighted = false;
+    DegreeSummary degree;        ///< Degree of undirected graphs, out-degree of directed graphs
+    DegreeSummary in_degree;     ///< In-degree; only filled for directed graphs
+    int weight_min = 0;          ///< Smallest edge weight (weighted graphs with edges only)
+    int weight_max = 0;          ///< Largest edge weight
+    double weight_mean = 0.0;    ///< Mean weight over adjacency entries
+};
+
+/**
+ * @brief Computes size and degree statistics in one O(n + m) pass
+ *
+ * Out-degrees come straight from the CSR row offsets; loops, in-degrees and
+ * weights from one scan over the edge arrays. The reductions run over plain
+ * contiguous arrays without branches, so the compiler vectorises them; no
+ * distance computation or adjacency matrix is needed.
+ *
+ * @tparam Direction Directed also computes the in-degree summary
+ * @param graph Graph to describe
+ * @return GraphStats Statistics of the graph
+ *
+ * @example
+ * GraphStats stats = compute_graph_stats<Undirected>(graph);
+ * print_graph_stats(stats);
+ */
+template <typename Direction>
+GraphStats compute_graph_stats(const Graph &graph);
+
+/**
+ * @brief Prints graph statistics, including the non-empty degree histogram buckets
+ *
+ * @param stats Statistics to print
+ * @param out Output stream
+ */
+extern void print_graph_stats(const GraphStats &stats, std::ostream &out = std::cout);
+
+#endif //GRAPH_STATS_H
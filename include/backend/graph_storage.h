@@ -0,0 +1,127 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef GRAPH_STORAGE_H
+#define GRAPH_STORAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Weight type of graphs whose edges all have weight 1; no weight array is stored
+ */
+struct NoWeight {};
+
+/**
+ * @brief Adjacency lists of all vertices in compressed sparse row (CSR) form
+ *
+ * Neighbours of vertex v are targets[offsets[v]] .. targets[offsets[v + 1] - 1],
+ * with weights at the same positions. Storing ids and weights in the narrowest
+ * type that fits keeps adjacency memory (and the bandwidth BFS needs) at
+ * 2-5 bytes per edge instead of 8.
+ *
+ * @tparam VertexId Unsigned integer type able to hold every vertex id
+ * @tparam EdgeWeight Unsigned integer type for weights, or NoWeight for unweighted graphs
+ */
+template <typename VertexId, typename EdgeWeight>
+struct CompactAdjacency {
+    using vertex_type = VertexId;
+    using weight_type = EdgeWeight;
+    static constexpr bool has_weights = !std::is_same_v<EdgeWeight, NoWeight>;
+
+    std::vector<std::size_t> offsets{0}; ///< Start of every row in targets, plus the total edge count
+    std::vector<VertexId> targets;       ///< Neighbour ids, row after row
+    std::vector<EdgeWeight> weights;     ///< Weight of every entry of targets; empty without weights
+
+    [[nodiscard]] int size() const { return static_cast<int>(offsets.size()) - 1; }
+    [[nodiscard]] std::size_t edge_count() const { return targets.size(); }
+    [[nodiscard]] std::size_t degree(const int v) const { return offsets[v + 1] - offsets[v]; }
+
+    [[nodiscard]] std::span<const VertexId> neighbours(const int v) const {
+        return {targets.data() + offsets[v], degree(v)};
+    }
+
+    [[nodiscard]] int weight(const std::size_t edge) const {
+        if constexpr (has_weights) return weights[edge];
+        else return 1;
+    }
+
+    /**
+     * @brief Calls fn(target, weight) for every neighbour of v, in stored order
+     */
+    template <typename Fn>
+    void for_each_neighbour(const int v, Fn&& fn) const {
+        for (std::size_t edge = offsets[v]; edge < offsets[v + 1]; edge++) {
+            fn(static_cast<int>(targets[edge]), weight(edge));
+        }
+    }
+
+    /**
+     * @brief Appends an entry to the row being built; call end_row after the last one
+     */
+    void push(const int target, const int w) {
+        targets.push_back(static_cast<VertexId>(target));
+        if constexpr (has_weights) weights.push_back(static_cast<EdgeWeight>(w));
+    }
+
+    void end_row() { offsets.push_back(targets.size()); }
+
+    /**
+     * @brief Bytes of heap storage held by the three arrays
+     */
+    [[nodiscard]] std::size_t bytes() const {
+        return offsets.capacity() * sizeof(std::size_t) + targets.capacity() * sizeof(VertexId)
+               + weights.capacity() * sizeof(EdgeWeight);
+    }
+};
+
+/**
+ * @brief Adjacency storage of a graph with the id and weight types chosen at creation
+ *
+ * Kernels call std::visit once and then run fully typed loops.
+ */
+using AdjacencyStorage = std::variant<CompactAdjacency<std::uint16_t, NoWeight>,
+                                      CompactAdjacency<std::uint16_t, std::uint8_t>,
+                                      CompactAdjacency<std::uint32_t, NoWeight>,
+                                      CompactAdjacency<std::uint32_t, std::uint8_t>>;
+
+/// Largest vertex count whose ids fit into 16 bits
+inline constexpr int max_compact_vertices = std::numeric_limits<std::uint16_t>::max() + 1;
+
+/**
+ * @brief Returns the bytes one vertex id takes in the storage chosen for n vertices
+ */
+constexpr std::size_t vertex_id_bytes(const int n) {
+    return n <= max_compact_vertices ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+}
+
+/**
+ * @brief Returns the bytes one adjacency entry (id plus optional weight) takes
+ */
+constexpr std::size_t adjacency_entry_bytes(const int n, const bool weighted) {
+    return vertex_id_bytes(n) + (weighted ? sizeof(std::uint8_t) : 0);
+}
+
+/**
+ * @brief Creates empty storage with the narrowest types for n vertices
+ *
+ * @param n Number of vertices
+ * @param weighted Whether weights (1-255) must be stored
+ * @return AdjacencyStorage Storage with no rows yet
+ */
+inline AdjacencyStorage make_adjacency_storage(const int n, const bool weighted) {
+    if (n <= max_compact_vertices) {
+        if (weighted) return CompactAdjacency<std::uint16_t, std::uint8_t>{};
+        return CompactAdjacency<std::uint16_t, NoWeight>{};
+    }
+    if (weighted) return CompactAdjacency<std::uint32_t, std::uint8_t>{};
+    return CompactAdjacency<std::uint32_t, NoWeight>{};
+}
+
+#endif //GRAPH_STORAGE_H
@@ -0,0 +1,140 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef GRAPH_WORKSPACE_H
+#define GRAPH_WORKSPACE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graph_gen.h"
+
+/**
+ * @brief Set of named graphs held by one console session
+ *
+ * Graphs are stored as immutable snapshots shared by reference counting:
+ * cloning a graph or handing it to a background job only copies a pointer.
+ * A snapshot is deep-copied only when it is modified while someone else
+ * still references it (copy-on-write).
+ *
+ * Every entry carries a version number that changes whenever the graph
+ * behind the name changes, so derived results can be keyed by it.
+ */
+class GraphWorkspace {
+public:
+    /**
+     * @brief Description of one named graph, as returned by list()
+     */
+    struct EntryInfo {
+        std::string name;
+        int n;                  ///< Number of vertices
+        std::size_t bytes;      ///< Memory of the snapshot (counted once however often it is shared)
+        long owners;            ///< Number of holders of the snapshot (names and running jobs)
+        std::uint64_t version;  ///< Version of the graph behind this name
+        bool current;           ///< True for the graph selected with use()
+    };
+
+    /**
+     * @brief Stores a graph under a name, replacing any previous graph with that name
+     *
+     * @param name Graph name
+     * @param graph Snapshot to store
+     * @return std::uint64_t New version of the entry
+     */
+    std::uint64_t put(const std::string& name, std::shared_ptr<const Graph> graph);
+
+    /**
+     * @brief Returns the snapshot stored under a name, or nullptr
+     */
+    [[nodiscard]] std::shared_ptr<const Graph> get(const std::string& name) const;
+
+    /**
+     * @brief Returns version of the graph stored under a name (0 if absent)
+     */
+    [[nodiscard]] std::uint64_t version(const std::string& name) const;
+
+    /**
+     * @brief Returns true if a graph with this name exists
+     */
+    [[nodiscard]] bool contains(const std::string& name) const;
+
+    /**
+     * @brief Makes a graph current
+     *
+     * @return false if no graph with this name exists
+     */
+    bool use(const std::string& name);
+
+    /**
+     * @brief Returns name of the current graph (empty if none)
+     */
+    [[nodiscard]] const std::string& current_name() const { return current; }
+
+    /**
+     * @brief Returns the current snapshot, or nullptr if the workspace is empty
+     */
+    [[nodiscard]] std::shared_ptr<const Graph> current_graph() const { return get(current); }
+
+    /**
+     * @brief Removes a graph; if it was current, the first remaining graph becomes current
+     *
+     * @return false if no graph with this name exists
+     */
+    bool drop(const std::string& name);
+
+    /**
+     * @brief Makes dst refer to the same snapshot as src without copying graph data
+     *
+     * @return false if src does not exist
+     */
+    bool clone(const std::string& src, const std::string& dst);
+
+    /**
+     * @brief Applies a modification to the graph stored under a name
+     *
+     * The snapshot is deep-copied first if it is shared with another name or
+     * a running job, so other holders keep seeing the old graph.
+     *
+     * @param name Graph name
+     * @param modify Function that changes the graph in place
+     * @return false if no graph with this name exists
+     */
+    bool modify(const std::string& name, const std::function<void(Graph&)>& modify);
+
+    /**
+     * @brief Removes all graphs
+     */
+    void clear();
+
+    [[nodiscard]] bool empty() const { return entries.empty(); }
+
+    /**
+     * @brief Lists all graphs ordered by name
+     */
+    [[nodiscard]] std::vector<EntryInfo> list() const;
+
+    /**
+     * @brief Checks that a string can be used as a graph name
+     *
+     * Names start with a letter or '_' and contain letters, digits, '_' or '-',
+     * so they are never confused with numeric arguments.
+     */
+    static bool is_valid_name(const std::string& name);
+
+private:
+    struct Entry {
+        std::shared_ptr<const Graph> snapshot;
+        std::uint64_t version;
+    };
+
+    std::map<std::string, Entry> entries;
+    std::string current;
+    std::uint64_t next_version = 1;
+};
+
+#endif //GRAPH_WORKSPACE_H
@@ -0,0 +1,120 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef HUB_LABELS_H
+#define HUB_LABELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cancellation.h"
+#include "memory_tracker.h"
+
+struct Graph;
+
+/**
+ * @brief Hub labels stored as flat arrays
+ *
+ * The entries of vertex v are [offsets[v], offsets[v + 1]): hub ids in
+ * increasing order with the distance to (or from) each hub. Every label
+ * ends with a sentinel entry whose hub is hub_sentinel, so a merge of two
+ * labels needs no bounds checks.
+ */
+struct LabelSet {
+    std::vector<std::uint64_t> offsets; ///< n + 1 offsets into hubs and distances
+    std::vector<int> hubs;              ///< Hub ranks, increasing within every label
+    std::vector<int> distances;         ///< Distance belonging to each hub entry
+};
+
+/// Hub id terminating every label; larger than any real hub rank
+inline constexpr int hub_sentinel = 0x7fffffff;
+
+/**
+ * @brief 2-hop cover distance index built by pruned landmark labeling
+ *
+ * Every vertex u has an out-label of hubs h with d(u, h) and every vertex v
+ * an in-label of hubs h with d(h, v), such that some shortest u-v path
+ * passes a hub in both labels. Then d(u, v) is the minimum of
+ * d(u, h) + d(h, v) over common hubs. For undirected graphs both labels are
+ * the same and only out is stored. Labels are indexed by user-facing ids, so
+ * a saved index does not depend on the storage order of the graph.
+ */
+struct HubLabels {
+    int n = 0;
+    bool directed = false;
+    bool weighted = false;            ///< Whether distances follow edge weights
+    std::uint64_t fingerprint = 0;    ///< graph_fingerprint of the graph the labels were built for
+    LabelSet out;                     ///< d(v, hub)
+    LabelSet in;                      ///< d(hub, v); empty for undirected graphs
+    TrackedBytes tracked;             ///< Accounted as query index memory
+
+    [[nodiscard]] const LabelSet& in_labels() const { return directed ? in : out; }
+
+    /**
+     * @brief Average number of hubs per label (sentinels not counted)
+     */
+    [[nodiscard]] double average_label_size() const;
+};
+
+/**
+ * @brief Builds hub labels with pruned landmark labeling (Akiba et al.)
+ *
+ * Vertices are processed in order of decreasing degree. Each runs a
+ * shortest-path search (BFS, or Dijkstra for weighted graphs) that stops
+ * at every vertex whose distance the labels built so far already cover,
+ * and otherwise adds itself as a hub to that vertex's label. High-degree
+ * vertices come first and cover most shortest paths, so later searches are
+ * pruned early and labels stay small on sparse and small-world graphs.
+ * Directed graphs run a forward search (in-labels) and a backward search
+ * over the incoming edges (out-labels) per vertex.
+ *
+ * @tparam Weight Weighted stores true weighted shortest distances, Unweighted counts edges
+ * @tparam Direction Directed builds separate in- and out-labels
+ * @param graph Graph to index
+ * @param token Optional cancellation token; progress is reported as one unit per vertex
+ * @return std::shared_ptr<const HubLabels> Labels, shareable between threads
+ *
+ * @throws std::length_error If the labels outgrow the memory budget while being built
+ * @throws OperationCancelled If token was cancelled during the build
+ *
+ * @note Label size, and with it build time and memory, depends on the graph:
+ *       small on road-like and social graphs, up to n per vertex on dense random graphs
+ */
+template <typename Weight, typename Direction>
+std::shared_ptr<const HubLabels> build_hub_labels(const Graph &graph, CancelToken *token = nullptr);
+
+/**
+ * @brief Returns the exact distance from u to v by merging their labels
+ *
+ * @param labels Labels of the graph
+ * @param u Source vertex (user-facing id)
+ * @param v Target vertex (user-facing id)
+ * @return Distance, -1 if v is unreachable from u
+ *
+ * @note Time complexity: O(|out(u)| + |in(v)|), a single pass over two sorted arrays
+ */
+extern int hub_distance(const HubLabels &labels, int u, int v);
+
+/**
+ * @brief Writes labels to a file
+ *
+ * The file starts with a 40-byte header (magic "GHL1", flags, n,
+ * fingerprint and entry counts) followed by the arrays of the out-labels and,
+ * for directed graphs, of the in-labels, in native byte order.
+ *
+ * @throws std::runtime_error If the file cannot be written
+ */
+extern void save_hub_labels(const HubLabels &labels, const std::string &path);
+
+/**
+ * @brief Reads labels written by save_hub_labels
+ *
+ * @throws std::runtime_error If the file cannot be read or is not a valid label file
+ */
+extern std::shared_ptr<const HubLabels> load_hub_labels(const std::string &path);
+
+#endif //HUB_LABELS_H
@@ -0,0 +1,158 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "cancellation.h"
+#include "memory_tracker.h"
+#include "point_queries.h"
+
+struct Graph;
+
+/**
+ * @brief How landmark vertices are chosen
+ */
+enum class LandmarkStrategy {
+    Degree,  ///< The k vertices of highest (out-)degree
+    Random,  ///< k vertices drawn uniformly at random
+    Farthest ///< Highest degree first, then repeatedly the vertex farthest from all landmarks chosen so far
+};
+
+/**
+ * @brief Parses a strategy name ("degree", "random" or "farthest")
+ *
+ * @return true if the name is known
+ */
+extern bool parse_landmark_strategy(std::string_view name, LandmarkStrategy &strategy);
+
+/**
+ * @brief Returns the name of a strategy, as accepted by parse_landmark_strategy
+ */
+extern const char* landmark_strategy_name(LandmarkStrategy strategy);
+
+/**
+ * @brief Shortest distances between k landmarks and every vertex
+ *
+ * Rows are per vertex: from[v * k + i] is the distance from landmark i to
+ * v, so a query reads two contiguous rows of k entries. Directed graphs
+ * also keep the distances from every vertex to the landmarks; undirected
+ * graphs leave to empty, since both directions are equal. -1 marks an
+ * unreachable pair. Vertex ids are stored ids (see internal_vertex).
+ */
+struct LandmarkTable {
+    int n = 0;
+    int k = 0;
+    LandmarkStrategy strategy = LandmarkStrategy::Degree;
+    std::vector<int> landmarks; ///< Stored id of every landmark
+    std::vector<int> from;      ///< n × k distances from the landmarks
+    std::vector<int> to;        ///< n × k distances to the landmarks (directed graphs only)
+    TrackedBytes tracked;       ///< Accounted as query index memory
+
+    /**
+     * @brief Row of distances towards v's landmarks: to for directed graphs, from for undirected ones
+     */
+    [[nodiscard]] const int* to_row(const int v) const {
+        return (to.empty() ? from.data() : to.data()) + static_cast<std::size_t>(v) * k;
+    }
+    [[nodiscard]] const int* from_row(const int v) const { return from.data() + static_cast<std::size_t>(v) * k; }
+};
+
+/**
+ * @brief Returns the memory of a landmark table
+ *
+ * @param n Number of vertices
+ * @param k Number of landmarks
+ * @param directed Whether distances to the landmarks are stored as well
+ */
+extern std::size_t estimate_landmark_footprint(int n, int k, bool directed);
+
+/**
+ * @brief Selects k landmarks and computes their distances to and from every vertex
+ *
+ * Runs one shortest-path search per landmark (and one backward search on
+ * directed graphs), spread over worker threads. Farthest-point selection
+ * needs the distances of the landmarks chosen so far, so its forward
+ * searches run one after another.
+ *
+ * @tparam Weight Weighted stores true weighted shortest distances (Dijkstra), Unweighted counts edges
+ * @tparam Direction Directed also stores the distances to the landmarks
+ * @param graph Graph to index
+ * @param k Number of landmarks (clamped to n)
+ * @param strategy How landmarks are chosen
+ * @param threads Worker threads (0 = hardware concurrency)
+ * @param seed Seed of the Random strategy (0 for random seed based on time)
+ * @param token Optional cancellation token; progress is reported as one unit per search
+ * @return std::shared_ptr<const LandmarkTable> Table, shareable between threads
+ *
+ * @throws std::invalid_argument If k < 1
+ * @throws OperationCancelled If token was cancelled during the build
+ *
+ * @note Time complexity: O(k · m) unweighted, O(k · m log n) weighted; memory: n · k ints
+ *       (twice that for directed graphs)
+ */
+template <typename Weight, typename Direction>
+std::shared_ptr<const LandmarkTable> build_landmarks(const Graph &graph, int k, LandmarkStrategy strategy,
+                                                     unsigned int threads = 1, unsigned int seed = 0,
+                                                     CancelToken *token = nullptr);
+
+/**
+ * @brief Lower and upper bound of a distance
+ */
+struct DistanceBounds {
+    int lower = 0;            ///< No path is shorter
+    int upper = -1;           ///< Length of a path through a landmark, -1 if no landmark connects the pair
+    bool unreachable = false; ///< A landmark proves there is no path at all
+};
+
+/**
+ * @brief Bounds the distance from u to v by the triangle inequality over all landmarks
+ *
+ * For every landmark l: d(u, v) >= d(l, v) - d(l, u) and
+ * d(u, v) >= d(u, l) - d(v, l), while d(u, l) + d(l, v) is the length of
+ * an actual path. If l reaches u but not v, or v reaches l but u does not,
+ * v is unreachable from u.
+ *
+ * @param table Landmark table of the graph
+ * @param u Source vertex (stored id)
+ * @param v Target vertex (stored id)
+ * @return DistanceBounds Best bounds over all landmarks, in O(k)
+ */
+extern DistanceBounds landmark_bounds(const LandmarkTable &table, int u, int v);
+
+/**
+ * @brief Computes an exact distance with A* guided by landmark bounds (ALT)
+ *
+ * The lower bound towards v serves as the A* potential; since it never
+ * overestimates and is consistent, the first time v is settled its distance
+ * is final. Good landmarks behind v steer the search towards it, so far
+ * fewer vertices are settled than by a plain search.
+ *
+ * @tparam Weight Must match the Weight the table was built with
+ * @param graph Graph to search
+ * @param table Landmark table of the graph
+ * @param u Source vertex (user-facing id)
+ * @param v Target vertex (user-facing id)
+ * @param workspace Scratch space, reused across queries
+ * @param token Optional cancellation token, polled once per settled vertex
+ * @return PointDistance Distance and number of vertices labelled
+ *
+ * @throws std::out_of_range If u or v is outside the valid range
+ * @throws OperationCancelled If token was cancelled during the search
+ *
+ * @example
+ * auto table = build_landmarks<Unweighted, Undirected>(graph, 16, LandmarkStrategy::Farthest);
+ * SearchWorkspace workspace;
+ * const PointDistance d = alt_distance<Unweighted>(graph, *table, 0, 42, workspace);
+ */
+template <typename Weight>
+PointDistance alt_distance(const Graph &graph, const LandmarkTable &table, int u, int v, SearchWorkspace &workspace,
+                           const CancelToken *token = nullptr);
+
+#endif //LANDMARKS_H
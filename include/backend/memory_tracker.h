@@ -0,0 +1,182 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Categories of backend structures whose memory is accounted
+ */
+enum class MemoryCategory {
+    AdjacencyMatrix,   ///< n×n adjacency matrix of the graph
+    AdjacencyList,     ///< Adjacency list of the graph
+    DistanceMatrix,    ///< All-pairs distance matrix built by analysis
+    Cache,             ///< Cached analysis results
+    Index,             ///< Query indexes kept alongside a graph (e.g. reachability)
+    Count              ///< Number of categories (not a real category)
+};
+
+/**
+ * @brief Current and peak number of bytes held by a category
+ */
+struct MemoryUsage {
+    std::size_t current; ///< Bytes currently held
+    std::size_t peak;    ///< Maximum bytes held since program start
+};
+
+/**
+ * @brief Records an allocation of given size in a category
+ *
+ * @param category Category that owns the memory
+ * @param bytes Number of bytes allocated
+ *
+ * @note Thread-safe
+ */
+extern void track_allocation(MemoryCategory category, std::size_t bytes);
+
+/**
+ * @brief Records a deallocation of given size in a category
+ *
+ * @param category Category that owned the memory
+ * @param bytes Number of bytes released (must match a previous track_allocation)
+ *
+ * @note Thread-safe
+ */
+extern void track_deallocation(MemoryCategory category, std::size_t bytes);
+
+/**
+ * @brief Returns current and peak usage of a category
+ */
+extern MemoryUsage get_memory_usage(MemoryCategory category);
+
+/**
+ * @brief Returns current and peak usage summed over all categories
+ *
+ * @note Total peak is the maximum of the sum, not the sum of per-category peaks
+ */
+extern MemoryUsage get_total_memory_usage();
+
+/**
+ * @brief Returns human-readable name of a category
+ */
+extern const char* memory_category_name(MemoryCategory category);
+
+/**
+ * @brief Returns resident set size of the process in bytes
+ *
+ * @return Current and peak RSS, or zeros if the platform does not expose them
+ */
+extern MemoryUsage get_process_rss();
+
+/**
+ * @brief Returns the amount of physical memory installed, in bytes (0 if unknown)
+ */
+extern std::size_t get_physical_memory();
+
+/**
+ * @brief Sets the memory budget used by memory_budget_allows
+ *
+ * @param bytes Budget in bytes; 0 selects the default (80% of physical memory)
+ */
+extern void set_memory_budget(std::size_t bytes);
+
+/**
+ * @brief Returns the effective memory budget in bytes (0 if unlimited)
+ */
+extern std::size_t get_memory_budget();
+
+/**
+ * @brief Checks whether an allocation of given size fits into the budget
+ *
+ * @param bytes Size of the planned allocation
+ * @param releasing Tracked bytes that will be released before the allocation happens
+ * @return true if current tracked usage - releasing + bytes does not exceed the budget
+ */
+extern bool memory_budget_allows(std::size_t bytes, std::size_t releasing = 0);
+
+/**
+ * @brief Returns how many bytes the budget leaves free beyond current tracked usage
+ *
+ * @return 0 if usage already exceeds the budget, SIZE_MAX if there is no budget
+ */
+extern std::size_t get_free_memory_budget();
+
+/**
+ * @brief Estimates memory footprint of a graph produced by create_graph
+ *
+ * Counts the adjacency matrix exactly and the adjacency list by the expected
+ * number of entries for given probabilities, using the compact id and weight
+ * types create_graph picks for n (see graph_storage.h).
+ *
+ * @param n Number of vertices
+ * @param edgeProb Edge probability
+ * @param loopProb Loop probability
+ * @param weighted Whether the graph stores edge weights
+ * @return Estimated size in bytes (saturates instead of overflowing)
+ */
+extern std::size_t estimate_graph_footprint(int n, double edgeProb, double loopProb, bool weighted = false);
+
+/**
+ * @brief Returns size of a full n×n distance matrix in bytes
+ */
+extern std::size_t estimate_distance_matrix_footprint(int n);
+
+/**
+ * @brief Formats byte count as "12.3 MiB"
+ */
+extern std::string format_bytes(std::size_t bytes);
+
+/**
+ * @brief Parses a size like "512", "64K", "512M", "4GiB" or "1.5GB" (binary units) into bytes
+ *
+ * @throws std::invalid_argument If the string is not a valid size, has trailing characters,
+ *         or does not fit in std::size_t
+ */
+extern std::size_t parse_byte_size(const std::string& str);
+
+/**
+ * @brief RAII helper that keeps bytes accounted in a category for its lifetime
+ *
+ * @example
+ * const auto dist_matrix = build_distance_matrix(graph);
+ * const TrackedBytes dist_bytes(MemoryCategory::DistanceMatrix, estimate_distance_matrix_footprint(graph.n));
+ */
+class TrackedBytes {
+public:
+    TrackedBytes() = default;
+    TrackedBytes(const MemoryCategory owner, const std::size_t size) : category(owner), bytes(size) {
+        track_allocation(category, bytes);
+    }
+    TrackedBytes(TrackedBytes&& other) noexcept : category(other.category), bytes(other.bytes) {
+        other.bytes = 0;
+    }
+    TrackedBytes& operator=(TrackedBytes&& other) noexcept {
+        if (this != &other) {
+            release();
+            category = other.category;
+            bytes = other.bytes;
+            other.bytes = 0;
+        }
+        return *this;
+    }
+    TrackedBytes(const TrackedBytes&) = delete;
+    TrackedBytes& operator=(const TrackedBytes&) = delete;
+    ~TrackedBytes() { release(); }
+
+    void release() {
+        if (bytes != 0) track_deallocation(category, bytes);
+        bytes = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const { return bytes; }
+
+private:
+    MemoryCategory category = MemoryCategory::Cache;
+    std::size_t bytes = 0;
+};
+
+#endif //MEMORY_TRACKER_H
@@ -0,0 +1,191 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef POINT_QUERIES_H
+#define POINT_QUERIES_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cancellation.h"
+#include "graph_storage.h"
+#include "memory_tracker.h"
+
+struct Graph;
+
+/**
+ * @brief Incoming adjacency of a directed graph, used by searches that run backwards from a target
+ *
+ * Row v lists the stored ids of all vertices with an edge to v, with the
+ * weights of those edges. The storage type is the one of the graph's own
+ * adjacency list.
+ */
+struct ReverseAdjacency {
+    AdjacencyStorage adj;
+    TrackedBytes tracked; ///< Accounted as adjacency list memory
+};
+
+/**
+ * @brief Builds the incoming adjacency of a graph in O(n + m)
+ *
+ * @param graph Graph whose edges are reversed
+ * @return std::shared_ptr<const ReverseAdjacency> Reversed adjacency, shareable between threads
+ */
+extern std::shared_ptr<const ReverseAdjacency> build_reverse_adjacency(const Graph &graph);
+
+/**
+ * @brief Reusable scratch space of point and neighbourhood queries
+ *
+ * Holds one forward and one backward label per vertex. The arrays are
+ * allocated once per graph size; a query only resets the entries the
+ * previous query touched, so a search that meets after a few hundred
+ * vertices costs a few hundred vertices, not n. One workspace must not be
+ * used by two threads at the same time.
+ */
+class SearchWorkspace {
+public:
+    /**
+     * @brief Makes all labels unset for a graph with n vertices
+     *
+     * Costs O(n) only when n differs from the previous call, otherwise
+     * O(vertices touched by the previous query).
+     */
+    void prepare(int n);
+
+    /**
+     * @brief Sets a label and remembers the vertex for the next reset
+     */
+    void label(std::vector<int>& labels, const int v, const int value) {
+        if (forward[v] == -1 && backward[v] == -1) touched.push_back(v);
+        labels[v] = value;
+    }
+
+    /**
+     * @brief Number of vertices the last query labelled
+     */
+    [[nodiscard]] std::size_t touched_count() const { return touched.size(); }
+
+    std::vector<int> forward;  ///< Distance from the source, -1 = not reached
+    std::vector<int> backward; ///< Distance to the target, -1 = not reached
+    std::vector<int> forward_parent;  ///< Vertex a forward label came from (valid only where forward is set)
+    std::vector<int> backward_parent; ///< Vertex a backward label came from, one step closer to the target
+    std::vector<int> frontier; ///< Scratch queue of the side being expanded (or of a bounded search)
+    std::vector<int> next;     ///< Scratch queue for the following level
+    std::vector<int> other_frontier;
+    std::vector<std::pair<int, int>> forward_heap;  ///< (distance, vertex) min-heaps of bidirectional Dijkstra
+    std::vector<std::pair<int, int>> backward_heap;
+
+private:
+    std::vector<int> touched;
+};
+
+/**
+ * @brief Result of a point-to-point distance query
+ */
+struct PointDistance {
+    int distance;         ///< Shortest distance, -1 if the target is unreachable
+    std::size_t touched;  ///< Vertices the two searches labelled before they met
+};
+
+/**
+ * @brief Computes the distance between two vertices with a bidirectional search
+ *
+ * A forward search from u and a backward search from v run alternately,
+ * always expanding the side with the smaller frontier, and stop as soon as
+ * no shorter connection than the best meeting found so far is possible.
+ * Unweighted graphs use level-synchronous bidirectional BFS; weighted graphs
+ * use bidirectional Dijkstra, stopping once the two heap minima together
+ * reach the best meeting distance.
+ *
+ * @tparam Weight Weighted returns shortest weighted distances, Unweighted counts edges
+ * @param graph Graph to search
+ * @param u Source vertex (user-facing id)
+ * @param v Target vertex (user-facing id)
+ * @param reverse Incoming adjacency for directed graphs (see build_reverse_adjacency);
+ *                nullptr for undirected graphs, whose edges work in both directions
+ * @param workspace Scratch space, reused across queries
+ * @param token Optional cancellation token, polled once per expanded vertex
+ * @return PointDistance Distance and search effort
+ *
+ * @throws std::out_of_range If u or v is outside the valid range
+ * @throws OperationCancelled If token was cancelled during the search
+ *
+ * @note For weighted graphs the result is the true shortest-path distance, which
+ *       can be smaller than the BFS-tree distance find reports
+ *
+ * @example
+ * SearchWorkspace workspace;
+ * const PointDistance d = point_distance<Unweighted>(graph, 0, 42, nullptr, workspace);
+ */
+template <typename Weight>
+PointDistance point_distance(const Graph &graph, int u, int v, const ReverseAdjacency *reverse,
+                             SearchWorkspace &workspace, const CancelToken *token = nullptr);
+
+/**
+ * @brief Result of a point-to-point path query
+ */
+struct PointPath {
+    int distance;              ///< Length of the path, -1 if the target is unreachable
+    std::vector<int> vertices; ///< The path from source to target (user-facing ids); empty if unreachable
+    std::size_t touched;       ///< Vertices the two searches labelled before they met
+};
+
+/**
+ * @brief Finds a shortest path between two vertices with a bidirectional search
+ *
+ * Runs the same search as point_distance; both sides record the vertex every
+ * label came from, and the path is read off from the meeting point towards
+ * both ends.
+ *
+ * @return PointPath Distance, path and search effort
+ *
+ * @throws std::out_of_range If u or v is outside the valid range
+ * @throws OperationCancelled If token was cancelled during the search
+ *
+ * @see point_distance for the parameters
+ */
+template <typename Weight>
+PointPath point_path(const Graph &graph, int u, int v, const ReverseAdjacency *reverse,
+                     SearchWorkspace &workspace, const CancelToken *token = nullptr);
+
+/**
+ * @brief Vertices found by a bounded search, in order of increasing distance
+ */
+struct Neighbourhood {
+    std::vector<int> vertices;  ///< User-facing ids, the source first
+    std::vector<int> distances; ///< Distance of each vertex from the source
+};
+
+/**
+ * @brief Collects all vertices within a distance limit of a source
+ *
+ * The search stops at the limit instead of exploring everything reachable:
+ * BFS never expands a vertex at the limit depth, Dijkstra never queues a
+ * vertex beyond the limit. Labels are kept in the workspace and reset
+ * through its touched list, so a query costs O(size of the neighbourhood
+ * and its edges), independent of n.
+ *
+ * @tparam Weight Weighted bounds the shortest weighted distance, Unweighted the number of edges (hops)
+ * @param graph Graph to search
+ * @param v Source vertex (user-facing id)
+ * @param limit Largest distance to include (>= 0)
+ * @param workspace Scratch space, reused across queries
+ * @param token Optional cancellation token, polled once per expanded vertex
+ * @return Neighbourhood Vertices with distance <= limit
+ *
+ * @throws std::out_of_range If v is outside the valid range
+ * @throws std::invalid_argument If limit is negative
+ * @throws OperationCancelled If token was cancelled during the search
+ *
+ * @example
+ * SearchWorkspace workspace;
+ * auto two_hops = bounded_search<Unweighted>(graph, 5, 2, workspace); // the 2-hop ball around vertex 5
+ */
+template <typename Weight>
+Neighbourhood bounded_search(const Graph &graph, int v, int limit, SearchWorkspace &workspace,
+                             const CancelToken *token = nullptr);
+
+#endif //POINT_QUERIES_H
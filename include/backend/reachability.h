@@ -0,0 +1,92 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cancellation.h"
+#include "components.h"
+#include "memory_tracker.h"
+
+struct Graph;
+
+/**
+ * @brief Transitive closure of a graph's strongly connected components
+ *
+ * Components are numbered in topological order of the condensation, so a
+ * component only reaches components with a larger or equal id. Row c of the
+ * closure holds one bit per component; bit d is set if c reaches d. When
+ * the condensation has no edges (always the case for undirected graphs) no
+ * rows are stored and reachability is component equality.
+ *
+ * All vertex ids are stored ids (see original_vertex / internal_vertex).
+ */
+struct ReachabilityIndex {
+    std::vector<int> component_of;      ///< Component of every vertex, in topological order
+    std::vector<int> reach_count;       ///< Number of vertices reachable from every component, itself included
+    std::vector<std::uint64_t> closure; ///< count rows of words 64-bit words each
+    std::size_t words = 0;              ///< Words per closure row; 0 if the condensation has no edges
+    int count = 0;                      ///< Number of components
+    TrackedBytes tracked;               ///< Accounted as query index memory
+
+    /**
+     * @brief Checks in O(1) whether v is reachable from u
+     */
+    [[nodiscard]] bool reaches(const int u, const int v) const {
+        const int from = component_of[u];
+        const int to = component_of[v];
+        if (words == 0 || to < from) return from == to;
+        return (closure[static_cast<std::size_t>(from) * words + to / 64] >> (to % 64)) & 1;
+    }
+
+    /**
+     * @brief Returns how many vertices are reachable from v, v itself included
+     */
+    [[nodiscard]] int reachable_count(const int v) const { return reach_count[component_of[v]]; }
+};
+
+/**
+ * @brief Returns the memory a reachability index over given components needs at most
+ *
+ * @param vertices Number of vertices of the graph
+ * @param components Number of strongly connected components
+ * @return Size in bytes, dominated by the components² / 8 bytes of the closure
+ */
+extern std::size_t estimate_reachability_footprint(int vertices, int components);
+
+/**
+ * @brief Builds the reachability index of a graph
+ *
+ * Collapses every strongly connected component into one node, orders the
+ * resulting DAG topologically (Kahn's algorithm) and computes the closure
+ * in reverse topological order: the row of a component is its own bit ORed
+ * with the rows of its successors, 64 components per machine word. Since
+ * successors have larger ids, only the words from the successor's own
+ * position onwards are ORed.
+ *
+ * @param graph Graph to index
+ * @param strong Result of find_strong_components for this graph (for
+ *        undirected graphs find_connected_components gives the same partition faster)
+ * @param token Optional cancellation token; progress is reported as one unit per component
+ * @return std::shared_ptr<const ReachabilityIndex> Index, shareable between threads
+ *
+ * @throws OperationCancelled If token was cancelled during the build
+ *
+ * @note Time complexity: O(n + m + c · m' / 64) for c components and m' condensed edges;
+ *       memory: c² / 8 bytes (see estimate_reachability_footprint)
+ *
+ * @example
+ * auto index = build_reachability_index(graph, find_strong_components(graph));
+ * if (index->reaches(internal_vertex(graph, u), internal_vertex(graph, v))) ...
+ */
+extern std::shared_ptr<const ReachabilityIndex> build_reachability_index(const Graph &graph,
+                                                                        const ComponentInfo &strong,
+                                                                        CancelToken *token = nullptr);
+
+#endif //REACHABILITY_H
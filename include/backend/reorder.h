@@ -0,0 +1,78 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <string_view>
+#include <vector>
+
+#include "graph_gen.h"
+
+/**
+ * @brief Strategy for renumbering vertices to improve memory locality
+ */
+enum class VertexOrder {
+    Rcm,    ///< Reverse Cuthill–McKee: BFS by increasing degree from a low-degree vertex, reversed
+    Degree, ///< Decreasing degree, so frequently visited hubs share cache lines
+    Bfs     ///< Breadth-first discovery order, so vertices are stored near their neighbours
+};
+
+/**
+ * @brief Parses a vertex order name ("rcm", "degree" or "bfs")
+ *
+ * @param name Order name
+ * @param order Receives the parsed order
+ * @return true if the name is known
+ */
+extern bool parse_vertex_order(std::string_view name, VertexOrder &order);
+
+/**
+ * @brief Computes a locality-improving permutation of the stored vertices
+ *
+ * Traversal-based orders restart from the next unvisited vertex whenever a
+ * traversal ends, so every component is covered. Ties are broken by vertex
+ * id, so the result is deterministic.
+ *
+ * @param graph Graph to order
+ * @param order Strategy to use
+ * @return std::vector<int> Permutation where result[new_v] is the stored vertex placed at new_v
+ *
+ * @note Time complexity: O(n + m) for BFS, O(n log n + m log d) for RCM and degree
+ */
+extern std::vector<int> compute_vertex_order(const Graph &graph, VertexOrder order);
+
+/**
+ * @brief Renumbers the stored vertices of a graph in place
+ *
+ * Matrix rows and columns, adjacency lists and the original_id/internal_id
+ * maps are all permuted, so user-facing ids stay the same and every
+ * command keeps printing the ids the graph was created with.
+ *
+ * @param graph Graph to renumber
+ * @param permutation result[new_v] = old stored vertex (see compute_vertex_order)
+ *
+ * @throws std::invalid_argument If permutation is not a permutation of 0..n-1
+ */
+extern void apply_vertex_order(Graph &graph, const std::vector<int> &permutation);
+
+/**
+ * @brief Computes the bandwidth of the stored numbering: max |u - v| over all edges
+ *
+ * Lower bandwidth means neighbours are stored closer together.
+ *
+ * @param graph Graph to measure
+ * @return int Bandwidth, 0 for a graph without edges
+ */
+extern int graph_bandwidth(const Graph &graph);
+
+/**
+ * @brief Makes a copy of a graph stored in its user-facing numbering
+ *
+ * @param graph Possibly reordered graph
+ * @return Graph Copy whose stored ids equal user-facing ids; must be freed with delete_graph
+ */
+extern Graph copy_in_original_order(const Graph &graph);
+
+#endif //REORDER_H
@@ -0,0 +1,136 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph_gen.h"
+#include "memory_tracker.h"
+
+/**
+ * @brief Distances from one source vertex, as cached by ResultCache
+ */
+struct CachedRow {
+    std::vector<int> distances; ///< Distance to every vertex (-1 = unreachable)
+    std::string order;          ///< BFS traversal order text; empty if the row comes from an analysis matrix
+};
+
+/**
+ * @brief Cache of traversal and analysis results keyed by graph version
+ *
+ * Results are valid for exactly one graph version (see GraphWorkspace), so a
+ * changed graph never sees stale data. Single-source rows are kept in an LRU
+ * list bounded by a byte budget; full analysis results are kept until their
+ * version is pruned. A row lookup for a version that has a cached analysis is
+ * answered from the analysis distance matrix without copying.
+ *
+ * @note Thread-safe: background jobs store results while the console reads them
+ */
+class ResultCache {
+public:
+    struct Stats {
+        std::size_t row_hits;
+        std::size_t row_misses;
+        std::size_t analysis_hits;
+        std::size_t analysis_misses;
+        std::size_t rows;          ///< Number of rows in the LRU
+        std::size_t row_bytes;     ///< Bytes held by LRU rows
+        std::size_t row_budget;    ///< LRU byte budget
+        std::size_t analyses;      ///< Number of cached analysis results
+    };
+
+    explicit ResultCache(std::size_t row_budget_bytes = default_row_budget);
+
+    /**
+     * @brief Looks up distances from a source vertex
+     *
+     * @return Row, or nullptr if neither the row nor an analysis of this version is cached
+     */
+    std::shared_ptr<const CachedRow> find_row(std::uint64_t version, int source);
+
+    /**
+     * @brief Looks up a single distance without copying the row
+     *
+     * @return Distance (-1 = unreachable), or std::nullopt if neither the row nor an analysis of this version is cached
+     */
+    std::optional<int> find_distance(std::uint64_t version, int source, int target);
+
+    /**
+     * @brief Stores distances from a source vertex, evicting least recently used rows over budget
+     */
+    void store_row(std::uint64_t version, int source, CachedRow row);
+
+    /**
+     * @brief Looks up a full analysis result
+     *
+     * @return Result, or nullptr if not cached
+     */
+    std::shared_ptr<const AnalysisResult> find_analysis(std::uint64_t version);
+
+    /**
+     * @brief Stores a full analysis result; rows of the same version become redundant and are dropped
+     */
+    void store_analysis(std::uint64_t version, std::shared_ptr<const AnalysisResult> result);
+
+    /**
+     * @brief Drops everything that does not belong to one of the given versions
+     */
+    void prune(const std::vector<std::uint64_t>& live_versions);
+
+    /**
+     * @brief Drops all cached results
+     */
+    void clear();
+
+    /**
+     * @brief Changes the LRU byte budget, evicting rows if needed
+     */
+    void set_row_budget(std::size_t bytes);
+
+    [[nodiscard]] Stats stats() const;
+
+    static constexpr std::size_t default_row_budget = 256ull * 1024 * 1024;
+
+private:
+    struct RowKey {
+        std::uint64_t version;
+        int source;
+        bool operator==(const RowKey&) const = default;
+    };
+
+    struct RowKeyHash {
+        std::size_t operator()(const RowKey& key) const noexcept {
+            return std::hash<std::uint64_t>()(key.version * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(key.source));
+        }
+    };
+
+    struct RowEntry {
+        std::shared_ptr<const CachedRow> row;
+        std::list<RowKey>::iterator lru_position;
+        TrackedBytes tracked;
+    };
+
+    mutable std::mutex mutex;
+    std::list<RowKey> lru;  ///< Most recently used first
+    std::unordered_map<RowKey, RowEntry, RowKeyHash> rows;
+    std::unordered_map<std::uint64_t, std::shared_ptr<const AnalysisResult>> analyses;
+    std::size_t row_bytes = 0;
+    std::size_t row_budget;
+    Stats counters{};
+
+    void erase_row(std::unordered_map<RowKey, RowEntry, RowKeyHash>::iterator it);
+    void evict_over_budget();
+    static std::size_t row_size(const CachedRow& row);
+};
+
+#endif //RESULT_CACHE_H
@@ -0,0 +1,135 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "cancellation.h"
+#include "generators.h"
+#include "graph_gen.h"
+
+/**
+ * @brief A graph restored from a snapshot file, with its analysis if one was saved
+ */
+struct Snapshot {
+    std::shared_ptr<Graph> graph;                    ///< Restored graph, in the storage order it was saved in
+    std::shared_ptr<const AnalysisResult> analysis;  ///< nullptr if the snapshot holds no analysis
+    bool directed = false;
+    bool weighted = false;
+    std::uint64_t fingerprint = 0;                   ///< graph_fingerprint of the graph
+};
+
+/**
+ * @brief Writes a graph and optionally its analysis to a snapshot file
+ *
+ * Layout: a fixed header (magic "GSN1", flags, n, edge count, graph
+ * fingerprint, radius, diameter, section sizes and checksums), then the
+ * adjacency list in CSR form with the storage order, then eccentricities,
+ * components, central and peripheral vertices, and finally the distance
+ * matrix, page-aligned, in the row layout of DistanceMatrixFile. All
+ * values are in native byte order.
+ *
+ * The file is written next to path and renamed over it when complete, so
+ * an interrupted save never leaves a truncated snapshot behind.
+ *
+ * @param path File to write
+ * @param graph Graph to save
+ * @param directed Direction policy of the graph
+ * @param weighted Weight policy of the graph
+ * @param analysis Analysis of graph to save, or nullptr to save the graph alone
+ * @param token Optional cancellation token; progress is reported per matrix row
+ *
+ * @throws std::runtime_error If the file cannot be written
+ * @throws OperationCancelled If token was cancelled; the partial file is removed
+ *
+ * @note Time complexity: O(n + m) plus O(n²) if the analysis holds a distance matrix
+ */
+extern void save_snapshot(const std::string &path, const Graph &graph, bool directed, bool weighted,
+                          const AnalysisResult *analysis, CancelToken *token = nullptr);
+
+/**
+ * @brief Restores a graph and its analysis from a snapshot file
+ *
+ * The graph and analysis sections are read and checked against their
+ * checksum, and the rebuilt graph against the saved fingerprint. The
+ * distance matrix is not read: it is mapped in place as the analysis'
+ * dist_file, so loading takes O(n + m) regardless of the matrix size.
+ *
+ * @param path File written by save_snapshot
+ * @param dense_matrix_limit Rebuild the adjacency matrix only if n does not exceed this
+ * @param verify_matrix Also read the whole distance matrix and check its checksum
+ * @return Snapshot Graph (freed with delete_graph when the last owner drops it) and analysis
+ *
+ * @throws std::runtime_error If the file cannot be read, is not a snapshot, or fails a checksum
+ */
+extern Snapshot load_snapshot(const std::string &path, int dense_matrix_limit = default_dense_matrix_limit,
+                              bool verify_matrix = false);
+
+/**
+ * @brief Writes a graph-only snapshot one block of rows at a time, for graphs too large to hold
+ *
+ * The result is the file save_snapshot writes for the whole graph without an
+ * analysis, so it is restored by load_snapshot. Row offsets and targets are
+ * written in place as blocks arrive and weights go to a side file; finish()
+ * appends the weights, reads the sections back once for their checksum and
+ * writes the header. Like save_snapshot, the file only appears at path once
+ * finish() succeeds.
+ */
+class SnapshotGraphWriter {
+public:
+    /**
+     * @param path File to write
+     * @param n Number of vertices
+     * @param directed Direction policy of the graph
+     * @param weighted Weight policy of the graph; blocks must then carry weights
+     *
+     * @throws std::runtime_error If the files cannot be created
+     */
+    SnapshotGraphWriter(const std::string &path, int n, bool directed, bool weighted);
+
+    /// Removes the partial files unless finish() succeeded
+    ~SnapshotGraphWriter();
+
+    SnapshotGraphWriter(const SnapshotGraphWriter&) = delete;
+    SnapshotGraphWriter& operator=(const SnapshotGraphWriter&) = delete;
+
+    /**
+     * @brief Appends the next block of rows
+     *
+     * @throws std::invalid_argument If the block does not start at the next row
+     * @throws std::runtime_error If writing fails
+     */
+    void write(const RowBlock &block);
+
+    /**
+     * @brief Completes the file once all n rows are written and moves it to path
+     *
+     * @throws std::runtime_error If rows are missing or writing fails
+     */
+    void finish();
+
+    /// Adjacency entries written so far
+    [[nodiscard]] std::uint64_t edges() const { return entries; }
+
+private:
+    std::string final_path;
+    std::string temporary;
+    std::string weights_path;
+    std::fstream file;
+    std::ofstream weights_file;
+    int vertices;
+    bool is_directed;
+    bool is_weighted;
+    int next_row = 0;
+    std::uint64_t entries = 0;
+    FingerprintBuilder fingerprint;
+    bool finished = false;
+};
+
+#endif //SNAPSHOT_H
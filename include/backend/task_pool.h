@@ -0,0 +1,84 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Returns how many threads to start for a number of tasks
+ *
+ * @param threads Requested threads (0 = hardware concurrency)
+ * @param tasks Number of independent tasks
+ * @return unsigned int Between 1 and max(threads, 1), never more than tasks
+ */
+inline unsigned int worker_count(unsigned int threads, const std::size_t tasks) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned int>(std::clamp<std::size_t>(tasks, 1, threads));
+}
+
+/**
+ * @brief Runs tasks [0, tasks) on a pool of worker threads
+ *
+ * Workers take the next task index from a shared counter, so uneven tasks
+ * balance themselves. Every worker owns one Workspace for all its tasks;
+ * once it runs out of tasks, finish(workspace) is called with the other
+ * workers excluded, which is where per-thread partial results are merged.
+ * The first exception (e.g. OperationCancelled) stops all workers, skips
+ * the remaining finish calls and is rethrown in the calling thread, which
+ * also works as one of the workers.
+ *
+ * @tparam Workspace Default-constructible per-thread state
+ * @param tasks Number of tasks
+ * @param threads Requested threads (0 = hardware concurrency)
+ * @param fn Called as fn(workspace, task) for every task
+ * @param finish Called as finish(workspace) once per worker
+ */
+template <typename Workspace, typename Fn, typename Finish>
+void for_each_task(const std::size_t tasks, const unsigned int threads, Fn fn, Finish finish) {
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+
+    auto worker = [&] {
+        Workspace workspace;
+        try {
+            for (std::size_t task = next++; task < tasks && !failed; task = next++) fn(workspace, task);
+            std::lock_guard lock(mutex);
+            if (!failed) finish(workspace);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!error) error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    const unsigned int workers = worker_count(threads, tasks);
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned int t = 1; t < workers; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    if (error) std::rethrow_exception(error);
+}
+
+/**
+ * @brief Runs tasks [0, tasks) on a pool of worker threads, without a merge step
+ */
+template <typename Workspace, typename Fn>
+void for_each_task(const std::size_t tasks, const unsigned int threads, Fn fn) {
+    for_each_task<Workspace>(tasks, threads, std::move(fn), [](Workspace&) {});
+}
+
+#endif //TASK_POOL_H
@@ -17,6 +17,22 @@ struct CommandConfig {
     std::string usage;
 };
 
+/**
+ * @brief Settings of the [performance] section
+ *
+ * Values are kept as written in the file; the console adapter validates and
+ * applies them.
+ */
+struct PerformanceConfig {
+    int threads = 0;                        ///< Worker threads for analysis and generation (0 = hardware concurrency)
+    std::string engine = "auto";            ///< Distance engine: auto, bfs, msbfs, dijkstra or floyd
+    std::string memory_budget = "auto";     ///< Byte size such as 512M, or auto
+    int dense_threshold = 2048;             ///< Generated graphs up to this many vertices also get an adjacency matrix
+    std::string output_buffering = "line";  ///< stdout buffering: none, line or full
+    std::string output_buffer_size = "64K"; ///< stdout buffer size for line and full buffering
+    std::string spill_dir;                  ///< Directory for distance matrices over the memory budget (empty = refuse instead)
+};
+
 struct ConsoleConfig {
     std::string prompt = "> ";
     std::string welcome_msg = "Console";
@@ -34,6 +50,8 @@ struct ConsoleConfig {
     int history_size = 100;
     bool press_to_exit = true;
 
+    PerformanceConfig performance;
+
     std::unordered_map<std::string, std::string> colors;
     std::vector<CommandConfig> commands;
 };
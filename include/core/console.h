@@ -1,8 +1,12 @@
 #ifndef UNIVERSAL_CONSOLE_H
 #define UNIVERSAL_CONSOLE_H
 
+#include <array>
+#include <charconv>
 #include <deque>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <functional>
 #include <iomanip>
@@ -31,7 +35,12 @@ using namespace std;
 
 class Console {
 public:
-    using CommandHandler = std::function<void(const std::vector<std::string>&)>;
+    /// Arguments of a command; views point into the input line and are valid only during the call
+    using CommandArgs = std::span<const std::string_view>;
+    using CommandHandler = std::function<void(CommandArgs)>;
+
+    /// Colour roles whose escape sequences are cached by setup_colors
+    enum class ColorRole { Error, Success, Warning, Info, Reset, Count };
 
     Console() : running(false) {
         config.prompt = "> ";
@@ -48,10 +57,12 @@ public:
         info.parameters = parameters;
         info.usage = usage.empty() ? build_usage(name, parameters) : usage;
         commands[name] = info;
+        rebuild_dispatch_table();
     }
 
     void register_alias(const std::string& alias, const std::string& command) {
         aliases[alias] = command;
+        rebuild_dispatch_table();
     }
 
     void set_config(const ConsoleConfig& newConfig) {
@@ -59,6 +70,10 @@ public:
         setup_colors();
     }
 
+    const ConsoleConfig& get_config() const {
+        return config;
+    }
+
     void run() {
         running = true;
         std::string input;
@@ -67,24 +82,81 @@ public:
             clear_screen();
         }
 
-        std::cout << get_color("info") << config.welcome_msg << reset_color() << std::endl;
+        std::cout << get_color(ColorRole::Info) << config.welcome_msg << reset_color() << std::endl;
         std::cout << "Type 'help' for available commands" << std::endl;
 
         while (running) {
-            std::cout << get_color("info") << config.prompt << reset_color();
-            std::getline(std::cin, input);
+            std::cout << get_color(ColorRole::Info) << config.prompt << reset_color();
+            if (!std::getline(std::cin, input)) break;
 
             if (input.empty()) continue;
 
             add_to_history(input);
-            process_input(input);
+            execute(input);
 
         }
     }
 
+    /**
+     * @brief Executes commands line by line without prompt, banner or colours
+     *
+     * Empty lines and lines starting with '#' are skipped. Execution stops at
+     * end of input or on 'exit'.
+     *
+     * @param input Stream with one command per line
+     * @return Number of commands that failed
+     */
+    int run_batch(std::istream& input) {
+        batch_mode = true;
+        config.colors_enabled = false;
+        config.press_to_exit = false;
+        setup_colors();
+
+        running = true;
+        int failures = 0;
+        std::string line;
+
+        while (running && std::getline(input, line)) {
+            const size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#') continue;
+
+            if (!execute(line)) failures++;
+        }
+
+        running = false;
+        return failures;
+    }
+
+    /**
+     * @brief Executes a single command line
+     *
+     * @return false if the command is unknown, threw, or called report_failure()
+     */
+    bool execute(const std::string& input) {
+        command_failed = false;
+        process_input(input);
+        return !command_failed;
+    }
+
+    /**
+     * @brief Marks the currently executing command as failed
+     *
+     * Command handlers call this on invalid arguments or missing state so that
+     * batch runs can report failures through the exit code.
+     */
+    void report_failure() const {
+        command_failed = true;
+    }
+
+    bool is_batch_mode() const {
+        return batch_mode;
+    }
+
     void stop() {
         running = false;
-        std::cout << get_color("success") << config.exit_msg << reset_color() << std::endl;
+        if (batch_mode) return;
+
+        std::cout << get_color(ColorRole::Success) << config.exit_msg << reset_color() << std::endl;
         if (config.press_to_exit) {
             std::cout << "Press Enter to continue...";
             std::cin.clear();
@@ -92,44 +164,70 @@ public:
         }
     }
 
-    static std::vector<std::string> tokenize(const std::string& input) {
-        std::vector<std::string> tokens;
-        std::istringstream iss(input);
-        std::string token;
-
-        while (iss >> token) {
-            tokens.push_back(token);
+    /**
+     * @brief Splits input on whitespace into views over the input buffer
+     *
+     * @param input Line to split; must outlive the produced views
+     * @param tokens Output vector; cleared first, its capacity is reused
+     */
+    static void tokenize(const std::string_view input, std::vector<std::string_view>& tokens) {
+        constexpr std::string_view whitespace = " \t\n\v\f\r";
+        tokens.clear();
+
+        size_t pos = input.find_first_not_of(whitespace);
+        while (pos != std::string_view::npos) {
+            const size_t end = input.find_first_of(whitespace, pos);
+            tokens.push_back(input.substr(pos, end - pos));
+            pos = input.find_first_not_of(whitespace, end);
         }
+    }
+
+    /**
+     * @brief Parses a whole argument as int without allocating
+     *
+     * @throws std::invalid_argument If the argument is not an integer
+     * @throws std::out_of_range If the value does not fit into int
+     */
+    static int parse_int(const std::string_view arg) {
+        return parse_number<int>(arg);
+    }
 
-        return tokens;
+    /**
+     * @brief Parses a whole argument as double without allocating
+     *
+     * @throws std::invalid_argument If the argument is not a number
+     * @throws std::out_of_range If the value does not fit into double
+     */
+    static double parse_double(const std::string_view arg) {
+        return parse_number<double>(arg);
     }
 
     void print_help() {
-        std::cout << get_color("info") << "Available commands:" << reset_color() << std::endl;
+        std::cout << get_color(ColorRole::Info) << "Available commands:" << reset_color() << std::endl;
         size_t max_name_length = 12;
         for (const auto &name: commands | views::keys) {
             max_name_length = std::max(max_name_length, name.length());
         }
 
         for (const auto& [name, info] : commands) {
-            std::cout << "  " << get_color("success") << std::setw(static_cast<int>(max_name_length))
+            std::cout << "  " << get_color(ColorRole::Success) << std::setw(static_cast<int>(max_name_length))
                       << std::left << name << reset_color() << " - " << info.description;
 
             if (!info.usage.empty()) {
-                std::cout << " " << get_color("warning") << "(" << info.usage << ")" << reset_color();
+                std::cout << " " << get_color(ColorRole::Warning) << "(" << info.usage << ")" << reset_color();
             }
             std::cout << std::endl;
         }
     }
 
-    void show_command_help(const std::string& command_name) {
-        std::string resolved = resolve_command(command_name);
+    void show_command_help(const std::string_view command_name) {
+        const DispatchEntry* entry = find_entry(command_name);
 
-        if (auto it = commands.find(resolved); it != commands.end()) {
-            const auto& info = it->second;
-            std::cout << get_color("info") << "Command: " << resolved << reset_color() << std::endl;
+        if (entry != nullptr && entry->info != nullptr) {
+            const auto& info = *entry->info;
+            std::cout << get_color(ColorRole::Info) << "Command: " << *entry->name << reset_color() << std::endl;
             std::cout << "  Description: " << info.description << std::endl;
-            std::cout << "  Usage: " << get_color("success") << info.usage << reset_color() << std::endl;
+            std::cout << "  Usage: " << get_color(ColorRole::Success) << info.usage << reset_color() << std::endl;
 
             if (!info.parameters.empty()) {
                 std::cout << "  Parameters:" << std::endl;
@@ -138,7 +236,8 @@ public:
                 }
             }
         } else {
-            std::cout << get_color("error") << "Unknown command: " << command_name << reset_color() << std::endl;
+            command_failed = true;
+            std::cout << get_color(ColorRole::Error) << "Unknown command: " << command_name << reset_color() << std::endl;
         }
     }
 
@@ -150,6 +249,7 @@ public:
     void load_aliases(const std::string& aliasPath) {
         auto newAliases = ConfigLoader::load_aliases(aliasPath);
         aliases.insert(newAliases.begin(), newAliases.end());
+        rebuild_dispatch_table();
     }
 
     std::unordered_map<std::string, std::string> get_aliases() {
@@ -157,6 +257,7 @@ public:
     }
 
     void clear_screen() {
+        if (batch_mode) return;
 #ifdef _WIN32
         std::system("cls");
 #else
@@ -165,7 +266,7 @@ public:
     }
 
     void show_history() {
-        std::cout << get_color("info") << "Command history (last " << command_history.size() << " commands):" << reset_color() << std::endl;
+        std::cout << get_color(ColorRole::Info) << "Command history (last " << command_history.size() << " commands):" << reset_color() << std::endl;
         for (size_t i = 0; i < command_history.size(); ++i) {
             std::cout << "  " << (i + 1) << ": " << command_history[i] << std::endl;
         }
@@ -173,6 +274,8 @@ public:
 
 private:
     bool running;
+    bool batch_mode = false;
+    mutable bool command_failed = false;
     std::deque<std::string> commands_history;
     ConsoleConfig config;
     std::deque<std::string> command_history;
@@ -184,60 +287,104 @@ private:
         std::string usage;
     };
 
+    enum class Builtin { None, Exit, Help, Clear, History };
+
+    /// Interned command or alias name resolved once, at registration time
+    struct DispatchEntry {
+        const std::string* name = nullptr;   ///< Canonical command name (alias target for aliases)
+        const CommandInfo* info = nullptr;   ///< Registered command, nullptr if unknown
+        Builtin builtin = Builtin::None;
+    };
+
+    // Node-based maps keep key and value addresses stable, so the dispatch
+    // table can hold views and pointers into them
     std::unordered_map<std::string, CommandInfo> commands;
     std::unordered_map<std::string, std::string> aliases;
-
-    std::string resolve_command(const std::string& input) {
-        const auto it = aliases.find(input);
-        return it != aliases.end() ? it->second : input;
+    std::unordered_map<std::string_view, DispatchEntry> dispatch_table;
+    std::vector<std::string_view> tokens_buffer;
+    std::array<std::string, static_cast<size_t>(ColorRole::Count)> color_cache;
+
+    inline static const std::array<std::string, 5> builtin_names = {"exit", "quit", "help", "clear", "history"};
+
+    template<typename T>
+    static T parse_number(const std::string_view arg) {
+        T value{};
+        const char* first = arg.data();
+        const char* last = arg.data() + arg.size();
+        if (first != last && *first == '+') ++first;
+
+        const auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec == std::errc::result_out_of_range) throw std::out_of_range("value out of range: " + std::string(arg));
+        if (ec != std::errc() || ptr != last) throw std::invalid_argument("invalid number: " + std::string(arg));
+        return value;
     }
 
-    void process_input(const std::string& input) {
-        auto tokens = tokenize(input);
-        if (tokens.empty()) return;
-
-        std::string commandName = tokens[0];
+    void rebuild_dispatch_table() {
+        dispatch_table.clear();
 
-        if (commandName == "exit" || commandName == "quit") {
-            stop();
-            return;
+        for (auto& [name, info] : commands) {
+            dispatch_table[name] = {&name, &info, Builtin::None};
         }
 
-        if (commandName == "help") {
-            if (tokens.size() > 1) {
-                show_command_help(tokens[1]);
-            } else {
-                print_help();
-            }
-            return;
+        // Aliases resolve to registered commands only, as before interning
+        for (const auto& [alias, target] : aliases) {
+            const auto it = commands.find(target);
+            dispatch_table[alias] = {it != commands.end() ? &it->first : &target,
+                                     it != commands.end() ? &it->second : nullptr, Builtin::None};
         }
 
-        if (commandName == "clear") {
-            clear_screen();
-            return;
+        // Built-in commands take precedence over registered ones with the same name
+        constexpr Builtin builtins[] = {Builtin::Exit, Builtin::Exit, Builtin::Help, Builtin::Clear, Builtin::History};
+        for (size_t i = 0; i < builtin_names.size(); i++) {
+            const auto it = commands.find(builtin_names[i]);
+            dispatch_table[builtin_names[i]] = {&builtin_names[i], it != commands.end() ? &it->second : nullptr, builtins[i]};
         }
+    }
 
-        if (commandName == "history") {
-            show_history();
-            return;
-        }
+    const DispatchEntry* find_entry(const std::string_view name) const {
+        const auto it = dispatch_table.find(name);
+        return it != dispatch_table.end() ? &it->second : nullptr;
+    }
 
-        std::string resolvedCommand = resolve_command(commandName);
-        if (resolvedCommand != commandName) {
-            tokens[0] = resolvedCommand;
+    void process_input(const std::string_view input) {
+        tokenize(input, tokens_buffer);
+        if (tokens_buffer.empty()) return;
+
+        const std::string_view commandName = tokens_buffer[0];
+        const DispatchEntry* entry = find_entry(commandName);
+
+        switch (entry != nullptr ? entry->builtin : Builtin::None) {
+            case Builtin::Exit:
+                stop();
+                return;
+            case Builtin::Help:
+                if (tokens_buffer.size() > 1) {
+                    show_command_help(tokens_buffer[1]);
+                } else {
+                    print_help();
+                }
+                return;
+            case Builtin::Clear:
+                clear_screen();
+                return;
+            case Builtin::History:
+                show_history();
+                return;
+            case Builtin::None:
+                break;
         }
 
-        commandName = resolvedCommand;
-
-        if (const auto it = commands.find(commandName); it != commands.end()) {
+        if (entry != nullptr && entry->info != nullptr) {
             try {
-                const std::vector<std::string> args(tokens.begin() + 1, tokens.end());
-                it->second.handler(args);
+                entry->info->handler(CommandArgs(tokens_buffer).subspan(1));
             } catch (const std::exception& e) {
-                std::cout << get_color("error") << "Error executing command: " << e.what() << reset_color() << std::endl;
+                command_failed = true;
+                std::cout << get_color(ColorRole::Error) << "Error executing command: " << e.what() << reset_color() << std::endl;
             }
         } else {
-            std::cout << get_color("error") << config.unknown_msg << ": " << commandName << reset_color() << std::endl;
+            command_failed = true;
+            const std::string_view resolved = entry != nullptr ? std::string_view(*entry->name) : commandName;
+            std::cout << get_color(ColorRole::Error) << config.unknown_msg << ": " << resolved << reset_color() << std::endl;
             if (config.show_help_on_unknown) {
                 std::cout << "Type 'help' for available commands" << std::endl;
             }
@@ -252,6 +399,7 @@ private:
     }
 
     void setup_colors() {
+        color_cache.fill("");
         if (!config.colors_enabled) {
             config.colors.clear();
             return;
@@ -282,26 +430,37 @@ private:
             {"bright_yellow", "\033[93m"},
             {"bright_blue", "\033[94m"}
         };
-    }
 
-    std::string get_color(const std::string& type) {
-        if (!config.colors_enabled) return "";
+        // Resolve role -> escape sequence once instead of on every print
+        const auto escape_for = [this](const std::string& color_name) {
+            const auto it = config.colors.find(color_name);
+            return it != config.colors.end() ? it->second : config.colors.at("reset");
+        };
+        color_cache[static_cast<size_t>(ColorRole::Error)] = escape_for(config.error_color);
+        color_cache[static_cast<size_t>(ColorRole::Success)] = escape_for(config.success_color);
+        color_cache[static_cast<size_t>(ColorRole::Warning)] = escape_for(config.warning_color);
+        color_cache[static_cast<size_t>(ColorRole::Info)] = escape_for(config.info_color);
+        color_cache[static_cast<size_t>(ColorRole::Reset)] = config.colors.at("reset");
+    }
 
-        std::string color_name;
-        if (type == "error") color_name = config.error_color;
-        else if (type == "success") color_name = config.success_color;
-        else if (type == "warning") color_name = config.warning_color;
-        else if (type == "info") color_name = config.info_color;
-        else color_name = "reset";
+public:
+    const std::string& get_color(const ColorRole role) const {
+        return color_cache[static_cast<size_t>(role)];
+    }
 
-        const auto it = config.colors.find(color_name);
-        return it != config.colors.end() ? it->second : config.colors.at("reset");
+    const std::string& get_color(const std::string_view type) const {
+        if (type == "error") return get_color(ColorRole::Error);
+        if (type == "success") return get_color(ColorRole::Success);
+        if (type == "warning") return get_color(ColorRole::Warning);
+        if (type == "info") return get_color(ColorRole::Info);
+        return get_color(ColorRole::Reset);
     }
 
-    std::string reset_color() {
-        return config.colors_enabled ? config.colors.at("reset") : "";
+    const std::string& reset_color() const {
+        return get_color(ColorRole::Reset);
     }
 
+private:
     std::string build_usage(const std::string& command, const std::vector<std::string>& parameters) {
         std::string usage = command;
         for (const auto& param : parameters) {
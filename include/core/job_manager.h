@@ -0,0 +1,130 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef JOB_MANAGER_H
+#define JOB_MANAGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../backend/cancellation.h"
+
+enum class JobState { Queued, Running, Done, Failed, Cancelled };
+
+/**
+ * @brief Snapshot of a job's state, safe to inspect without locks
+ */
+struct JobStatus {
+    int id = 0;
+    std::string description;
+    JobState state = JobState::Queued;
+    std::size_t done = 0;      ///< Progress units completed
+    std::size_t total = 0;     ///< Progress units expected (0 if unknown)
+    double seconds = 0.0;      ///< Run time so far, or total run time once finished
+    std::string output;        ///< Text the job wrote (filled only by JobManager::wait)
+    std::string error;         ///< Exception message for failed jobs
+};
+
+/**
+ * @brief Runs long commands on a background worker thread
+ *
+ * Jobs are executed one at a time in submission order. Each job writes its
+ * output to a private buffer and polls its CancelToken; the buffer is handed
+ * back by wait(). Finished jobs stay listed until they are waited for.
+ *
+ * While a job runs, Ctrl-C (after install_interrupt_handler) cancels it
+ * instead of terminating the process.
+ */
+class JobManager {
+public:
+    using Task = std::function<void(std::ostream& out, CancelToken& token)>;
+    using ProgressCallback = std::function<void(const JobStatus&)>;
+
+    JobManager();
+    ~JobManager();
+
+    JobManager(const JobManager&) = delete;
+    JobManager& operator=(const JobManager&) = delete;
+
+    /**
+     * @brief Queues a task for background execution
+     *
+     * @param description Text shown by 'jobs'
+     * @param task Function to run; throws OperationCancelled when cancelled
+     * @return int Job id
+     */
+    int submit(const std::string& description, Task task);
+
+    /**
+     * @brief Requests cancellation of a queued or running job
+     *
+     * @return false if no such job exists or it has already finished
+     */
+    bool cancel(int id);
+
+    /**
+     * @brief Blocks until the job finishes, then removes it from the list
+     *
+     * @param id Job id
+     * @param on_progress Called periodically (about every 200 ms) while waiting
+     * @param status Receives the final status including the job's output
+     * @return false if no such job exists
+     */
+    bool wait(int id, const ProgressCallback& on_progress, JobStatus& status);
+
+    /**
+     * @brief Returns status snapshots of all known jobs ordered by id
+     */
+    std::vector<JobStatus> list() const;
+
+    /**
+     * @brief Returns true if a job is queued or running
+     */
+    bool has_active_jobs() const;
+
+    /**
+     * @brief Installs a Ctrl-C handler that cancels the running job instead of exiting
+     *
+     * When no job is running, Ctrl-C prints a hint and is otherwise ignored.
+     */
+    static void install_interrupt_handler();
+
+    static const char* state_name(JobState state);
+
+private:
+    struct Job {
+        int id;
+        std::string description;
+        Task task;
+        JobState state = JobState::Queued;
+        CancelToken token;
+        std::string output;
+        std::string error;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point finished;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable queue_cv;
+    std::condition_variable finished_cv;
+    std::map<int, std::shared_ptr<Job>> jobs;
+    std::deque<std::shared_ptr<Job>> queue;
+    int next_id = 1;
+    bool stopping = false;
+    std::thread worker;
+
+    void worker_loop();
+    static JobStatus make_status(const Job& job);
+};
+
+#endif //JOB_MANAGER_H
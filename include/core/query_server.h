@@ -0,0 +1,140 @@
+//
+// Created by IWOFLEUR on 18.10.2026.
+//
+
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Line-based request/response server on a Unix domain socket
+ *
+ * Every request is one line of text and gets exactly one response line, in
+ * request order per connection. One event-loop thread multiplexes all
+ * connections with poll(); requests are answered by a pool of worker
+ * threads, so many clients are served concurrently. Requests a client has
+ * pipelined are handed to a worker as one batch, which keeps the per-request
+ * overhead low for point queries. A client that pipelines faster than it
+ * reads its responses is not read from until its backlog drains.
+ *
+ * The handler is called from worker threads and must be thread-safe.
+ *
+ * @note Needs Unix domain sockets; on platforms without them the constructor throws
+ *
+ * @example
+ * QueryServer server("/tmp/graph.sock", [](std::string_view line) { return "OK " + std::string(line); }, 4);
+ * QueryClient client("/tmp/graph.sock");
+ * std::string reply = client.request("ping"); // "OK ping"
+ */
+class QueryServer {
+public:
+    using Handler = std::function<std::string(std::string_view request)>;
+
+    struct Stats {
+        std::size_t connections; ///< Connections accepted so far
+        std::size_t active;      ///< Connections currently open
+        std::size_t requests;    ///< Requests answered so far
+    };
+
+    /// Longest accepted request line; longer requests get an error and the connection is closed
+    static constexpr std::size_t max_request_bytes = 64 * 1024;
+
+    /// Queued requests or unsent responses per connection beyond which it is not read until they drain
+    static constexpr std::size_t max_pending_bytes = 1024 * 1024;
+
+    /**
+     * @brief Binds the socket and starts the event loop and worker threads
+     *
+     * A stale socket file at socket_path is replaced.
+     *
+     * @param socket_path Filesystem path of the socket
+     * @param handler Computes the response line (without newline) for a request line
+     * @param threads Worker threads (0 = hardware concurrency)
+     *
+     * @throws std::runtime_error If the socket cannot be created or bound
+     */
+    QueryServer(std::string socket_path, Handler handler, unsigned int threads);
+
+    /**
+     * @brief Stops serving, closes all connections and removes the socket file
+     */
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    [[nodiscard]] const std::string& path() const { return socket_path; }
+    [[nodiscard]] Stats stats() const;
+
+private:
+    struct Batch {
+        int client;                     ///< Id of the connection the requests came from
+        std::vector<std::string> lines; ///< Requests in arrival order
+        std::string responses;          ///< Filled by a worker: one line per request
+    };
+
+    std::string socket_path;
+    Handler handler;
+
+    int listen_fd = -1;
+    int wake_read = -1;  ///< Pipe that wakes the event loop when a worker finishes a batch
+    int wake_write = -1;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<std::size_t> connection_count{0};
+    std::atomic<std::size_t> active_count{0};
+    std::atomic<std::size_t> request_count{0};
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::deque<Batch> pending;  ///< Batches waiting for a worker
+    std::deque<Batch> finished; ///< Batches waiting for the event loop to send their responses
+
+    std::thread event_thread;
+    std::vector<std::thread> workers;
+
+    void event_loop();
+    void worker_loop();
+    void wake() const;
+};
+
+/**
+ * @brief Blocking client for QueryServer
+ */
+class QueryClient {
+public:
+    /**
+     * @throws std::runtime_error If the socket cannot be connected
+     */
+    explicit QueryClient(const std::string& socket_path);
+    ~QueryClient();
+
+    QueryClient(const QueryClient&) = delete;
+    QueryClient& operator=(const QueryClient&) = delete;
+
+    /**
+     * @brief Sends one request line and waits for its response line
+     *
+     * @param line Request without newline
+     * @return std::string Response without newline
+     *
+     * @throws std::runtime_error If the connection fails or is closed by the server
+     */
+    std::string request(std::string_view line);
+
+private:
+    int fd = -1;
+    std::string buffer; ///< Received bytes not yet returned
+};
+
+#endif //QUERY_SERVER_H
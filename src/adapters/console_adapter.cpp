@@ -9,21 +9,321 @@
 #include <windows.h>
 #include <shlobj.h>
 #else
+#include <pwd.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <stdio.h>
 #endif
 
 #include "../../include/adapters/console_adapter.h"
+#include "../../include/backend/centrality.h"
+#include "../../include/backend/components.h"
+#include "../../include/backend/generators.h"
 #include "../../include/backend/graph_gen.h"
+#include "../../include/backend/graph_stats.h"
+#include "../../include/backend/memory_tracker.h"
+#include "../../include/backend/reorder.h"
+#include "../../include/backend/snapshot.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <tuple>
 #include <utility>
 
 namespace fs = std::filesystem;
 
-GraphConsoleAdapter::GraphConsoleAdapter(const bool is_weighted, const bool is_directed ,const std::string& config_path, const std::string& aliases_path): graphs_created(false), graph(nullptr), n(0) {
+namespace {
+    /**
+     * Answers query-server requests against one immutable graph snapshot.
+     * Rows and analyses go through the shared result cache, so the console
+     * and the server reuse each other's work.
+     *
+     * Protocol (one line each way):
+     *   info           -> OK n=<n> weighted=<0|1> directed=<0|1>
+     *   dist <u> <v>   -> OK <distance>                 (-1 = unreachable; bidirectional search, see point_distance)
+     *   path <u> <v>   -> OK <distance> <u> ... <v>     (just "OK -1" if unreachable)
+     *   ball <v> <k>   -> OK <vertex>:<hops> ...        (vertices at most k edges away)
+     *   within <v> <d> -> OK <vertex>:<distance> ...    (vertices at most d away)
+     *   find <v>       -> OK <d0> <d1> ... <dn-1>
+     *   analyse        -> OK radius=<r> diameter=<d> components=<c> central=<v,...> peripheral=<v,...>
+     * Errors are answered with "ERR <message>".
+     */
+    class QuerySession {
+    public:
+        using Search = std::vector<int> (*)(const Graph&, int, std::ostream*, const CancelToken*, std::vector<int>*);
+        using Point = PointDistance (*)(const Graph&, int, int, const ReverseAdjacency*, SearchWorkspace&,
+                                        const CancelToken*);
+        using Bounded = Neighbourhood (*)(const Graph&, int, int, SearchWorkspace&, const CancelToken*);
+        using Path = PointPath (*)(const Graph&, int, int, const ReverseAdjacency*, SearchWorkspace&,
+                                   const CancelToken*);
+        using Analyse = AnalysisResult (*)(const Graph&, CancelToken*, const AnalysisOptions&);
+
+        QuerySession(std::shared_ptr<const Graph> graph, const std::uint64_t graph_version, const bool is_weighted,
+                     const bool is_directed, std::shared_ptr<const ReverseAdjacency> incoming, const Search search_fn,
+                     const Point point_fn, const Path path_fn, const Bounded within_fn, const Analyse analyse_fn,
+                     AnalysisOptions analysis_options, ResultCache& result_cache)
+            : snapshot(std::move(graph)), version(graph_version), weighted(is_weighted), directed(is_directed),
+              reverse(std::move(incoming)), search(search_fn), point(point_fn), path(path_fn), within(within_fn),
+              analyse(analyse_fn),
+              options(std::move(analysis_options)), cache(result_cache) {}
+
+        std::string answer(const std::string_view request) {
+            std::istringstream in{std::string(request)};
+            std::string command;
+            in >> command;
+
+            if (command == "info") {
+                return "OK n=" + std::to_string(snapshot->n) + " weighted=" + (weighted ? "1" : "0")
+                       + " directed=" + (directed ? "1" : "0");
+            }
+            if (command == "dist") {
+                const int u = read_vertex(in);
+                const int v = read_vertex(in);
+                // Cached BFS rows hold shortest distances only for unweighted graphs
+                if (!weighted) {
+                    if (const auto distance = cache.find_distance(version, u, v)) return "OK " + std::to_string(*distance);
+                }
+                thread_local SearchWorkspace workspace;
+                return "OK " + std::to_string(point(*snapshot, u, v, reverse.get(), workspace, nullptr).distance);
+            }
+            if (command == "path") {
+                const int u = read_vertex(in);
+                const int v = read_vertex(in);
+                std::vector<int> vertices;
+                int distance;
+                if (const auto cached = cache.find_analysis(version); cached != nullptr && cached->shortest_paths) {
+                    vertices = path_from_distances(*snapshot, *cached, u, v);
+                    distance = distance_row(*cached, u)[v];
+                } else {
+                    thread_local SearchWorkspace workspace;
+                    PointPath found = path(*snapshot, u, v, reverse.get(), workspace, nullptr);
+                    vertices = std::move(found.vertices);
+                    distance = found.distance;
+                }
+
+                std::string response = "OK " + std::to_string(distance);
+                for (const int x : vertices) response += " " + std::to_string(x);
+                return response;
+            }
+            if (command == "ball" || command == "within") {
+                const int v = read_vertex(in);
+                int limit;
+                if (!(in >> limit)) throw std::invalid_argument("missing or invalid distance limit");
+
+                thread_local SearchWorkspace workspace;
+                const Neighbourhood hood = command == "ball"
+                                               ? bounded_search<Unweighted>(*snapshot, v, limit, workspace, nullptr)
+                                               : within(*snapshot, v, limit, workspace, nullptr);
+                std::string response = "OK";
+                for (std::size_t i = 0; i < hood.vertices.size(); i++) {
+                    response += " " + std::to_string(hood.vertices[i]) + ":" + std::to_string(hood.distances[i]);
+                }
+                return response;
+            }
+            if (command == "find") {
+                const int v = read_vertex(in);
+                std::vector<int> distances;
+                if (const auto cached = cache.find_row(version, v)) distances = cached->distances;
+                else distances = row_from(v);
+
+                std::string response = "OK";
+                for (const int d : distances) response += " " + std::to_string(d);
+                return response;
+            }
+            if (command == "analyse") {
+                const auto result = analysis();
+                std::string response = "OK radius=" + std::to_string(result->radius) + " diameter="
+                                       + std::to_string(result->diameter) + " components="
+                                       + std::to_string(result->components.count);
+                response += " central=" + join(result->central);
+                response += " peripheral=" + join(result->peripheral);
+                return response;
+            }
+            return "ERR unknown request '" + command + "' (info, dist, path, ball, within, find, analyse)";
+        }
+
+    private:
+        std::shared_ptr<const Graph> snapshot;
+        std::uint64_t version;
+        bool weighted;
+        bool directed;
+        std::shared_ptr<const ReverseAdjacency> reverse; // nullptr for undirected graphs
+        Search search;
+        Point point;
+        Path path;
+        Bounded within;
+        Analyse analyse;
+        AnalysisOptions options;
+        ResultCache& cache;
+        std::mutex analysis_mutex; // one analysis at a time; later requests get the cached result
+
+        int read_vertex(std::istringstream& in) const {
+            int v;
+            if (!(in >> v)) throw std::invalid_argument("missing or invalid vertex");
+            if (v < 0 || v >= snapshot->n) {
+                throw std::out_of_range("vertex " + std::to_string(v) + " out of range 0.." + std::to_string(snapshot->n - 1));
+            }
+            return v;
+        }
+
+        std::vector<int> row_from(const int source) const {
+            // Same row as 'find' computes, so the console can serve it from the cache too
+            std::ostringstream order;
+            CachedRow row;
+            row.distances = search(*snapshot, source, &order, nullptr, nullptr);
+            row.order = order.str();
+            std::vector<int> distances = row.distances;
+            cache.store_row(version, source, std::move(row));
+            return distances;
+        }
+
+        std::shared_ptr<const AnalysisResult> analysis() {
+            std::lock_guard lock(analysis_mutex);
+            if (auto cached = cache.find_analysis(version)) return cached;
+
+            if (const std::size_t footprint = estimate_distance_matrix_footprint(snapshot->n);
+                !memory_budget_allows(footprint)) {
+                throw std::runtime_error("distance matrix needs " + format_bytes(footprint) + ", over the memory budget");
+            }
+            auto result = std::make_shared<const AnalysisResult>(analyse(*snapshot, nullptr, options));
+            cache.store_analysis(version, result);
+            return result;
+        }
+
+        static std::string join(const std::vector<int>& vertices) {
+            std::string text;
+            for (const int v : vertices) text += (text.empty() ? "" : ",") + std::to_string(v);
+            return text.empty() ? "none" : text;
+        }
+    };
+
+    /**
+     * Builds the reachability index of a graph if it fits the memory budget;
+     * otherwise says why on out and returns nullptr.
+     */
+    std::shared_ptr<const ReachabilityIndex> build_index_within_budget(const Graph& graph, const bool directed,
+                                                                       const std::size_t releasing, std::ostream& out,
+                                                                       CancelToken* token) {
+        const ComponentInfo strong = directed ? find_strong_components(graph) : find_connected_components(graph);
+        check_cancelled(token);
+        const std::size_t footprint = estimate_reachability_footprint(graph.n, strong.count);
+        if (!memory_budget_allows(footprint, releasing)) {
+            out << "Reachability index of " << strong.count << " components needs " << format_bytes(footprint)
+                << ", memory budget is " << format_bytes(get_memory_budget()) << std::endl;
+            return nullptr;
+        }
+        return build_reachability_index(graph, strong, token);
+    }
+
+    /**
+     * Formats value with a fixed number of decimals in a stream of its own,
+     * so the precision of the stream it is printed to stays untouched.
+     */
+    std::string format_fixed(const double value, const int decimals) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(decimals) << value;
+        return text.str();
+    }
+
+    /**
+     * Reads the vertex pairs of a dist batch file: one "u v" pair per line,
+     * blank lines and lines starting with '#' are skipped.
+     */
+    std::vector<std::pair<int, int>> read_vertex_pairs(const std::string& path, const int n) {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("cannot open '" + path + "'");
+
+        std::vector<std::pair<int, int>> pairs;
+        std::string line;
+        for (int line_number = 1; std::getline(file, line); line_number++) {
+            const std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') continue;
+
+            int u;
+            int v;
+            std::string rest;
+            std::istringstream numbers(line);
+            if (!(numbers >> u >> v) || (numbers >> rest)) {
+                throw std::runtime_error(path + ":" + std::to_string(line_number) + ": expected \"<u> <v>\"");
+            }
+            if (u < 0 || u >= n || v < 0 || v >= n) {
+                throw std::runtime_error(path + ":" + std::to_string(line_number) + ": vertex out of range 0.."
+                                         + std::to_string(n - 1));
+            }
+            pairs.emplace_back(u, v);
+        }
+        return pairs;
+    }
+
+    /**
+     * Reads the parameters of spec.model and an optional trailing "--seed <s>"
+     * into spec; seed 0 is replaced by a random one, so it can be reported.
+     */
+    void parse_model_params(ModelSpec& spec, Console::CommandArgs args) {
+        if (args.size() >= 2 && args[args.size() - 2] == "--seed") {
+            spec.seed = static_cast<unsigned int>(Console::parse_int(args.back()));
+            args = args.first(args.size() - 2);
+        }
+        if (spec.seed == 0) spec.seed = std::random_device{}() | 1u;
+
+        const auto require = [&args](const std::size_t count) {
+            if (args.size() != count) throw std::invalid_argument("expected " + std::to_string(count) + " parameters");
+        };
+
+        switch (spec.model) {
+            case GraphModel::Rmat:
+                if (args.size() != 2) require(5);
+                spec.scale = Console::parse_int(args[0]);
+                spec.edge_factor = Console::parse_int(args[1]);
+                if (args.size() == 5) {
+                    spec.a = Console::parse_double(args[2]);
+                    spec.b = Console::parse_double(args[3]);
+                    spec.c = Console::parse_double(args[4]);
+                }
+                break;
+            case GraphModel::BarabasiAlbert:
+                require(2);
+                spec.n = Console::parse_int(args[0]);
+                spec.attach = Console::parse_int(args[1]);
+                break;
+            case GraphModel::WattsStrogatz:
+                require(3);
+                spec.n = Console::parse_int(args[0]);
+                spec.neighbours = Console::parse_int(args[1]);
+                spec.rewire = Console::parse_double(args[2]);
+                break;
+            case GraphModel::Grid:
+                require(2);
+                spec.rows = Console::parse_int(args[0]);
+                spec.cols = Console::parse_int(args[1]);
+                break;
+        }
+
+        if (const std::string problem = validate_model_spec(spec); !problem.empty()) {
+            throw std::invalid_argument(problem);
+        }
+    }
+}
+
+template <typename Fn>
+decltype(auto) GraphConsoleAdapter::dispatch_policies(Fn&& fn) const {
+    if (weighted) {
+        if (directed) return fn(Weighted{}, Directed{});
+        return fn(Weighted{}, Undirected{});
+    }
+    if (directed) return fn(Unweighted{}, Directed{});
+    return fn(Unweighted{}, Undirected{});
+}
+
+GraphConsoleAdapter::GraphConsoleAdapter(const bool is_weighted, const bool is_directed ,const std::string& config_path, const std::string& aliases_path) {
     weighted = is_weighted;
     directed = is_directed;
 
@@ -56,6 +356,7 @@ GraphConsoleAdapter::GraphConsoleAdapter(const bool is_weighted, const bool is_d
 
     console.load_config(actual_config_path);
     console.load_aliases(actual_aliases_path);
+    apply_performance_config(console.get_config().performance);
 
     register_graph_commands();
 }
@@ -65,16 +366,25 @@ GraphConsoleAdapter::~GraphConsoleAdapter() {
 }
 
 void GraphConsoleAdapter::run() {
+    JobManager::install_interrupt_handler();
     console.run();
 }
 
-void GraphConsoleAdapter::cleanup() {
-    if (graph != nullptr) {
-        delete_graph(*graph, graph->n);
-        graph.reset();
+int GraphConsoleAdapter::run_batch(std::istream &input) {
+    int failures = console.run_batch(input);
+
+    // Collect background jobs the script did not wait for, so their failures count too
+    for (const JobStatus& job : jobs.list()) {
+        if (!wait_job(job.id)) failures++;
     }
-    n = 0;
-    graphs_created = false;
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void GraphConsoleAdapter::cleanup() {
+    // Memory is released once running jobs drop their references too
+    workspace.clear();
+    cache.clear();
 }
 
 void GraphConsoleAdapter::cmd_smile() {
@@ -120,101 +430,509 @@ std::string GraphConsoleAdapter::get_default_config_path() {
 #endif
 }
 
+void GraphConsoleAdapter::apply_memory_budget(const std::string &value) {
+    try {
+        set_memory_budget(value.empty() || value == "auto" ? 0 : parse_byte_size(value));
+    } catch (const std::exception&) {
+        std::cout << "Invalid memory_budget '" << value << "', using default" << std::endl;
+        set_memory_budget(0);
+    }
+}
+
+void GraphConsoleAdapter::apply_performance_config(const PerformanceConfig &performance) {
+    // Buffering first: stdio allows setvbuf only before the first output
+    int mode = _IOLBF;
+    if (performance.output_buffering == "none") mode = _IONBF;
+    else if (performance.output_buffering == "full") mode = _IOFBF;
+    else if (performance.output_buffering != "line") {
+        std::cout << "Invalid output_buffering '" << performance.output_buffering << "', using line" << std::endl;
+    }
+
+    std::size_t buffer_size = 0;
+    try {
+        buffer_size = parse_byte_size(performance.output_buffer_size);
+    } catch (const std::exception&) {
+        std::cout << "Invalid output_buffer_size '" << performance.output_buffer_size << "', using default" << std::endl;
+    }
+    if (mode == _IONBF || buffer_size == 0) {
+        std::setvbuf(stdout, nullptr, mode, 0);
+    } else {
+        // Never freed: stdio flushes it at exit, after static destructors have run
+        char* buffer = new char[buffer_size];
+        std::setvbuf(stdout, buffer, mode, buffer_size);
+    }
+
+    apply_memory_budget(performance.memory_budget);
+
+    if (performance.threads < 0) {
+        std::cout << "Invalid threads '" << performance.threads << "', using all cores" << std::endl;
+    }
+    analysis_options.threads = static_cast<unsigned int>(std::max(performance.threads, 0));
+
+    if (!parse_distance_engine(performance.engine, analysis_options.engine)) {
+        std::cout << "Invalid engine '" << performance.engine << "', using auto" << std::endl;
+        analysis_options.engine = DistanceEngine::Auto;
+    }
+
+    if (performance.dense_threshold < 0) {
+        std::cout << "Invalid dense_threshold '" << performance.dense_threshold << "', using default" << std::endl;
+    }
+    dense_matrix_limit = performance.dense_threshold < 0 ? default_dense_matrix_limit : performance.dense_threshold;
+    spill_dir = performance.spill_dir;
+}
+
 void GraphConsoleAdapter::register_graph_commands() {
     console.register_command("create",
-            [this](const std::vector<std::string>& args) { this->cmd_create(args); },
-            "Create a new graph system",
-            {"vertices", "edge_probability", "loop_probability"},
-            "create <n> <edgeProb> <loopProb>"
+            [this](Console::CommandArgs args) { this->cmd_create(args); },
+            "Create a new graph (replaces the current one if no name is given)",
+            {"name", "vertices", "edge_probability", "loop_probability"},
+            "create [name] <n> <edgeProb> <loopProb> | create [name] --model <rmat|ba|ws|grid> <params...> [--seed <s>]"
         );
 
+    console.register_command("generate",
+        [this](Console::CommandArgs args) { this->cmd_generate(args); },
+        "Generate a model graph straight to a file, a block of rows at a time (append & to run in background)",
+        {"--model", "--seed", "--out", "--text"},
+        "generate --model <rmat|ba|ws|grid> <params...> [--seed <s>] --out <file> [--text] [&]"
+    );
+
+    console.register_command("use",
+        [this](Console::CommandArgs args) { this->cmd_use(args); },
+        "Select the current graph",
+        {"name"},
+        "use <name>"
+    );
+
+    console.register_command("list",
+        [this](Console::CommandArgs) { this->cmd_list(); },
+        "List graphs in the workspace"
+    );
+
+    console.register_command("drop",
+        [this](Console::CommandArgs args) { this->cmd_drop(args); },
+        "Remove a graph from the workspace",
+        {"name"},
+        "drop <name>"
+    );
+
+    console.register_command("clone",
+        [this](Console::CommandArgs args) { this->cmd_clone(args); },
+        "Share a graph under a new name without copying it",
+        {"source", "name"},
+        "clone [source] <name>"
+    );
+
     console.register_command("print",
-        [this](const std::vector<std::string>&) { this->cmd_print(); },
+        [this](Console::CommandArgs) { this->cmd_print(); },
         "Print current graph system"
     );
 
     console.register_command("clear",
-        [this](const std::vector<std::string>&) { this->cmd_clear(); },
+        [this](Console::CommandArgs) { this->cmd_clear(); },
         "Clear console screen"
     );
 
     console.register_command("cleanup",
-        [this](const std::vector<std::string>&) { this->cmd_cleanup(); },
-        "Cleanup graph system and free memory"
+        [this](Console::CommandArgs) { this->cmd_cleanup(); },
+        "Drop all graphs and free memory"
     );
 
     console.register_command("help",
-       [this](const std::vector<std::string>& args) { this->cmd_help(args); },
+       [this](Console::CommandArgs args) { this->cmd_help(args); },
        "Show help for commands",
        {"command"},
        "help [command]"
    );
 
     console.register_command("exit",
-        [this](const std::vector<std::string>&) { this->cmd_exit(); },
+        [this](Console::CommandArgs) { this->cmd_exit(); },
         "Exit the application"
     );
 
     console.register_command("history",
-        [this](const std::vector<std::string>&) { this->cmd_history(); },
+        [this](Console::CommandArgs) { this->cmd_history(); },
             "Show history of commands"
     );
 
     console.register_command("smile",
-        [this](const std::vector<std::string>&) { cmd_smile(); },
+        [this](Console::CommandArgs) { cmd_smile(); },
         "SMILE!!!!!"
     );
 
     console.register_command("find",
-        [this](const std::vector<std::string>& args) { this->cmd_find(args); },
-        "Find distances from selected vertex"
+        [this](Console::CommandArgs args) { this->cmd_find(args); },
+        "Find distances from selected vertex (--tree adds the BFS tree), or to the nearest of several (append & to run in background)",
+        {"start_v"},
+        "find [--tree] [start_v ...] [&]"
+    );
+
+    console.register_command("dist",
+        [this](Console::CommandArgs args) { this->cmd_dist(args); },
+        "Find the distance between two vertices, or between the pairs listed in a file",
+        {"u", "v"},
+        "dist <u> <v> | dist ~<u> <v> | dist --alt <u> <v> | dist --file <pairs> [&]"
+    );
+
+    console.register_command("landmarks",
+        [this](Console::CommandArgs args) { this->cmd_landmarks(args); },
+        "Precompute distances from k landmarks for 'dist ~u v' bounds and 'dist --alt' searches",
+        {"build", "clear", "degree", "random", "farthest"},
+        "landmarks [build <k> [degree|random|farthest] | clear]"
+    );
+
+    console.register_command("labels",
+        [this](Console::CommandArgs args) { this->cmd_labels(args); },
+        "Build, save or load hub labels that answer 'dist u v' exactly without a search",
+        {"build", "save", "load", "clear"},
+        "labels [build | save <file> | load <file> | clear]"
+    );
+
+    console.register_command("path",
+        [this](Console::CommandArgs args) { this->cmd_path(args); },
+        "Show a shortest path between two vertices",
+        {"u", "v"},
+        "path <u> <v>"
+    );
+
+    console.register_command("reach",
+        [this](Console::CommandArgs args) { this->cmd_reach(args); },
+        "Check whether one vertex is reachable from another, or for the pairs listed in a file",
+        {"u", "v"},
+        "reach <u> <v> | reach --file <pairs>"
+    );
+
+    console.register_command("ball",
+        [this](Console::CommandArgs args) { this->cmd_neighbourhood(args, true); },
+        "List vertices at most k edges away from a vertex",
+        {"v", "k"},
+        "ball <v> <k>"
+    );
+
+    console.register_command("within",
+        [this](Console::CommandArgs args) { this->cmd_neighbourhood(args, false); },
+        "List vertices at most the given distance away from a vertex",
+        {"v", "dist"},
+        "within <v> <dist>"
+    );
+
+    console.register_command("centrality",
+        [this](Console::CommandArgs args) { this->cmd_centrality(args); },
+        "Rank vertices by closeness, harmonic or betweenness centrality (--sample estimates from k sources)",
+        {"closeness", "harmonic", "betweenness", "--sample", "--top"},
+        "centrality <closeness|harmonic|betweenness> [--sample <k>] [--top <k>] [&]"
     );
 
     console.register_command("analyse",
-        [this](const std::vector<std::string>&) {this->cmd_analyse(); },
-        "Analyse the graph"
+        [this](Console::CommandArgs args) {this->cmd_analyse(args); },
+        "Analyse the graph; --out-of-core keeps the distance matrix in a file (append & to run in background)",
+        {"--out-of-core"},
+        "analyse [--out-of-core <file>] [&]"
+    );
+
+    console.register_command("snapshot",
+        [this](Console::CommandArgs args) { this->cmd_snapshot(args); },
+        "Save the graph with its analysis to a file, or restore a saved session from one",
+        {"save", "load", "--verify"},
+        "snapshot save <file> [&] | snapshot load <file> [name] [--verify]"
+    );
+
+    console.register_command("components",
+        [this](Console::CommandArgs) { this->cmd_components(); },
+        "List connected components (strongly connected for directed graphs)"
+    );
+
+    console.register_command("reorder",
+        [this](Console::CommandArgs args) { this->cmd_reorder(args); },
+        "Renumber stored vertices for memory locality; output keeps the original ids",
+        {"rcm", "degree", "bfs"},
+        "reorder <rcm|degree|bfs>"
+    );
+
+    console.register_command("cache",
+        [this](Console::CommandArgs args) { this->cmd_cache(args); },
+        "Show result cache statistics, clear it or set the row budget",
+        {"clear", "budget"},
+        "cache [clear | budget <size>]"
+    );
+
+    console.register_command("jobs",
+        [this](Console::CommandArgs) { this->cmd_jobs(); },
+        "List background jobs with progress"
+    );
+
+    console.register_command("wait",
+        [this](Console::CommandArgs args) { this->cmd_wait(args); },
+        "Wait for a background job and print its output",
+        {"id"},
+        "wait <id>"
+    );
+
+    console.register_command("cancel",
+        [this](Console::CommandArgs args) { this->cmd_cancel(args); },
+        "Cancel a queued or running job",
+        {"id"},
+        "cancel <id>"
+    );
+
+    console.register_command("stats",
+        [this](Console::CommandArgs args) { this->cmd_stats(args); },
+        "Show vertex, edge and degree statistics of the current graph",
+        {"graph"},
+        "stats graph"
+    );
+
+    console.register_command("mem",
+        [this](Console::CommandArgs args) { this->cmd_mem(args); },
+        "Show memory usage or set memory budget",
+        {"budget", "size"},
+        "mem [budget <size|auto>]"
+    );
+
+    console.register_command("serve",
+        [this](Console::CommandArgs args) { this->cmd_serve(args); },
+        "Serve the current graph to other processes on a Unix domain socket",
+        {"socket", "--wait", "stop"},
+        "serve [<socket> [--wait] | stop]"
+    );
+
+    console.register_command("query",
+        [this](Console::CommandArgs args) { this->cmd_query(args); },
+        "Send one request to a graph server (info, dist <u> <v>, find <v>, analyse)",
+        {"socket", "request"},
+        "query <socket> <request...>"
+    );
+
+    console.register_command("perf",
+        [this](Console::CommandArgs args) { this->cmd_perf(args); },
+        "Show or change analysis threads and distance engine",
+        {"threads", "engine"},
+        "perf [threads <n> | engine <auto|bfs|msbfs|dijkstra|floyd>]"
     );
 }
 
-void GraphConsoleAdapter::cmd_create(const std::vector<std::string>& args) {
+void GraphConsoleAdapter::cmd_create(Console::CommandArgs args) {
     try {
-        const int new_n = args.empty() ? 5 : std::stoi(args[0]);
-        const double new_edge_prob = args.size() > 1 ?  std::stod(args[1]) : 0.5;
-        const double new_loop_prob = args.size() > 2 ?  std::stod(args[2]) : 0.3;
+        std::string name = workspace.empty() ? default_graph_name : workspace.current_name();
+        if (!args.empty() && GraphWorkspace::is_valid_name(std::string(args[0]))) {
+            name = args[0];
+            args = args.subspan(1);
+        }
+
+        if (!args.empty() && args[0] == "--model") {
+            create_model(name, args.subspan(1));
+            return;
+        }
+
+        const int new_n = args.empty() ? 5 : Console::parse_int(args[0]);
+        const double new_edge_prob = args.size() > 1 ?  Console::parse_double(args[1]) : 0.5;
+        const double new_loop_prob = args.size() > 2 ?  Console::parse_double(args[2]) : 0.3;
 
         if (new_n <= 0) {
             std::cout << "Invalid number of vertices." << std::endl;
+            console.report_failure();
             return;
         }
         if (new_edge_prob <= 0 || new_edge_prob > 1 || new_loop_prob <= 0 || new_loop_prob > 1) {
             std::cout << "Probabilities must be between 0 and 1" << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        if (!create_budget_allows(name, estimate_graph_footprint(new_n, new_edge_prob, new_loop_prob, weighted))) {
             return;
         }
 
-        cleanup();
+        const auto generate = dispatch_policies([](auto weight, auto direction) {
+            return &create_graph<decltype(weight), decltype(direction)>;
+        });
 
-        n = new_n;
-        graph = std::make_unique<Graph>(create_graph(n, new_edge_prob, new_loop_prob, 0, weighted, directed));
-        graphs_created = true;
+        workspace.drop(name);
+        workspace.put(name, make_shared_graph(generate(new_n, new_edge_prob, new_loop_prob, 0)));
+        workspace.use(name);
+        prune_cache();
 
-        std::cout << "Created two graphs with " << n << " vertices" << std::endl;
+        std::cout << "Created graph '" << name << "' with " << new_n << " vertices" << std::endl;
         std::cout << "  Edge probability: " << new_edge_prob << ", Loop probability: " << new_loop_prob << std::endl;
 
     } catch (const std::exception& e) {
         std::cout << "Error creating graphs: " << e.what() << std::endl;
-        std::cout << "Usage: create <vertices> <edge_probability> <loop_probability>" << std::endl;
+        std::cout << "Usage: create [name] <vertices> <edge_probability> <loop_probability>" << std::endl;
+        console.report_failure();
     }
 }
 
-void GraphConsoleAdapter::cmd_print() const {
-    if (!graphs_created) {
-        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+bool GraphConsoleAdapter::create_budget_allows(const std::string &name, const std::size_t footprint) const {
+    // The replaced graph is freed only if no other name or running job shares it
+    const auto replaced = workspace.get(name);
+    const std::size_t releasing = replaced != nullptr && replaced.use_count() == 2
+                                      ? graph_matrix_bytes(*replaced) + graph_list_bytes(*replaced)
+                                      : 0;
+    if (memory_budget_allows(footprint, releasing)) return true;
+
+    std::cout << "Refusing to create graph: estimated footprint " << format_bytes(footprint)
+              << " exceeds memory budget " << format_bytes(get_memory_budget())
+              << " (in use: " << format_bytes(get_total_memory_usage().current - releasing) << ")" << std::endl;
+    std::cout << "Use fewer vertices or raise the budget with 'mem budget <size>'" << std::endl;
+    console.report_failure();
+    return false;
+}
+
+void GraphConsoleAdapter::create_model(const std::string &name, Console::CommandArgs args) {
+    constexpr const char* usage = "Usage: create [name] --model rmat <scale> <edge_factor> [a b c] [--seed <s>]\n"
+                                  "       create [name] --model ba <n> <edges_per_vertex> [--seed <s>]\n"
+                                  "       create [name] --model ws <n> <k> <rewire_probability> [--seed <s>]\n"
+                                  "       create [name] --model grid <rows> <cols> [--seed <s>]";
+    ModelSpec spec;
+    if (args.empty() || !parse_graph_model(args[0], spec.model)) {
+        std::cout << "Unknown or missing model. Models: rmat, ba, ws, grid" << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
         return;
     }
+    args = args.subspan(1);
+
+    try {
+        parse_model_params(spec, args);
+        if (!create_budget_allows(name, estimate_model_footprint(spec, weighted, dense_matrix_limit))) return;
+
+        const auto generate = dispatch_policies([](auto weight, auto direction) {
+            return &generate_model_graph<decltype(weight), decltype(direction)>;
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        Graph graph = generate(spec, dense_matrix_limit, analysis_options.threads);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        const int n = graph.n;
+        const bool has_matrix = graph.adj_matrix != nullptr;
+
+        workspace.drop(name);
+        workspace.put(name, make_shared_graph(std::move(graph)));
+        workspace.use(name);
+        prune_cache();
+
+        std::cout << "Created graph '" << name << "' with " << n << " vertices" << std::endl;
+        std::cout << "  Model: " << graph_model_name(spec.model) << ", seed: " << spec.seed << ", "
+                  << format_fixed(elapsed.count(), 1) << " ms"
+                  << (has_matrix ? "" : ", no adjacency matrix (sparse storage only)") << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error creating graph: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_generate(Console::CommandArgs args) {
+    const char* usage = "Usage: generate --model <rmat|ba|ws|grid> <params...> [--seed <s>] --out <file> [--text] [&]\n"
+                        "       (model parameters as for 'create --model')";
+    // Blocks take half of what the budget leaves free; below the minimum passes would dominate
+    constexpr std::size_t min_block_memory = std::size_t{4} << 20;
+    constexpr std::size_t max_block_memory = std::size_t{1} << 30;
+
+    try {
+        const bool background = strip_background_flag(args);
+        std::string path;
+        bool text = false;
+        std::vector<std::string_view> model_args;
+        for (std::size_t i = 0; i < args.size(); i++) {
+            if (args[i] == "--out" && i + 1 < args.size()) path = args[++i];
+            else if (args[i] == "--text") text = true;
+            else model_args.push_back(args[i]);
+        }
+        if (path.empty()) throw std::invalid_argument("missing --out <file>");
+
+        ModelSpec spec;
+        if (model_args.size() < 2 || model_args[0] != "--model" || !parse_graph_model(model_args[1], spec.model)) {
+            throw std::invalid_argument("unknown or missing model; models: rmat, ba, ws, grid");
+        }
+        parse_model_params(spec, Console::CommandArgs(model_args).subspan(2));
+
+        const std::size_t block_memory = std::min(get_free_memory_budget() / 2, max_block_memory);
+        if (block_memory < min_block_memory) {
+            std::cout << "Refusing to generate: blocks need at least " << format_bytes(2 * min_block_memory)
+                      << " of free memory budget, " << format_bytes(get_free_memory_budget()) << " is free (budget "
+                      << format_bytes(get_memory_budget()) << ")" << std::endl;
+            std::cout << "Drop graphs or raise the budget with 'mem budget <size>'" << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        const auto stream = dispatch_policies([](auto weight, auto direction) {
+            return &stream_model_graph<decltype(weight), decltype(direction)>;
+        });
+
+        run_job("generate " + std::string(graph_model_name(spec.model)) + " -> " + path,
+                [spec, path, text, stream, block_memory, threads = analysis_options.threads, directed = directed,
+                 weighted = weighted](std::ostream& out, CancelToken& token) {
+            const auto start = std::chrono::steady_clock::now();
+            const int n = model_vertex_count(spec);
+            std::uint64_t edges = 0;
+            int blocks = 0;
+
+            if (text) {
+                // Written next to path and renamed when complete, like snapshots
+                const std::string temporary = path + ".tmp";
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                if (!file) throw std::runtime_error("cannot create '" + temporary + "'");
+                try {
+                    file << "# " << graph_model_name(spec.model) << " seed=" << spec.seed << " n=" << n
+                         << " directed=" << directed << " weighted=" << weighted << '\n';
+                    blocks = stream(spec, block_memory, threads, [&](const RowBlock& block) {
+                        write_edge_list(file, block, directed, threads);
+                        edges += block.targets.size();
+                    }, &token);
+                    file.close();
+                    if (!file) throw std::runtime_error("cannot write '" + temporary + "'");
+                    fs::rename(temporary, path);
+                } catch (...) {
+                    if (file.is_open()) file.close();
+                    std::error_code ignored;
+                    fs::remove(temporary, ignored);
+                    throw;
+                }
+            } else {
+                SnapshotGraphWriter writer(path, n, directed, weighted);
+                blocks = stream(spec, block_memory, threads, [&writer](const RowBlock& block) {
+                    writer.write(block);
+                }, &token);
+                writer.finish();
+                edges = writer.edges();
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+            out << "Generated " << graph_model_name(spec.model) << " graph with " << n << " vertices and "
+                << (directed ? edges : edges / 2) << " edges to " << path << (text ? " (edge list)" : " (snapshot)")
+                << std::endl;
+            out << "  Seed: " << spec.seed << ", " << blocks << (blocks == 1 ? " block" : " blocks") << " of up to "
+                << format_bytes(block_memory) << ", " << format_fixed(elapsed.count(), 1) << " ms" << std::endl;
+        }, background);
+    } catch (const std::exception& e) {
+        std::cout << "Error in generate: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_print() const {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+
+    std::cout << "=== GRAPH '" << workspace.current_name() << "' ===" << std::endl;
+
+    // Show the graph as the user created it, not in its storage order
+    const bool reordered = !graph->original_id.empty();
+    Graph original{};
+    if (reordered) original = copy_in_original_order(*graph);
+    const Graph& shown = reordered ? original : *graph;
+
+    if (shown.adj_matrix != nullptr) {
+        print_matrix(shown.adj_matrix, shown.n, shown.n, "Adjacency Matrix");
+    } else {
+        std::cout << "(no adjacency matrix: generated graphs above " << dense_matrix_limit
+                  << " vertices keep only the list)" << std::endl;
+    }
+    print_list(shown, "Adjacency List");
 
-    std::cout << "=== GRAPH ===" << std::endl;
-    print_matrix(graph->adj_matrix, graph->n, graph->n, "Adjacency Matrix");
-    print_list(graph->adj_list, "Adjacency List");
+    if (reordered) delete_graph(original, original.n);
 }
 
 void GraphConsoleAdapter::cmd_clear() {
@@ -231,7 +949,7 @@ void GraphConsoleAdapter::cmd_exit() {
     console.stop();
 }
 
-void GraphConsoleAdapter::cmd_help(const std::vector<std::string>& args) {
+void GraphConsoleAdapter::cmd_help(Console::CommandArgs args) {
     if (args.empty()) {
         console.print_help();
     } else {
@@ -243,77 +961,1306 @@ void GraphConsoleAdapter::cmd_history() {
     console.show_history();
 }
 
-void GraphConsoleAdapter::cmd_find(const std::vector<std::string> &args) const {
-    if (!graphs_created) {
-        std::cout << "No graphs created. Use 'create' command first." << std::endl;
-        return;
-    }
+void GraphConsoleAdapter::cmd_find(Console::CommandArgs args) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const int n = graph->n;
 
     try {
-        const int start_v = args.empty() ? 0 : std::stoi(args[0]);
+        const bool background = strip_background_flag(args);
+        const bool tree = !args.empty() && args[0] == "--tree";
+        if (tree) args = args.subspan(1);
+
+        std::vector<int> sources;
+        for (const auto& arg : args) sources.push_back(Console::parse_int(arg));
+        if (sources.empty()) sources.push_back(0);
+        if (tree && sources.size() > 1) throw std::invalid_argument("--tree takes a single start vertex");
+
+        for (const int v : sources) {
+            if (v < 0 || v >= n) {
+                std::cout << "Invalid start vertex. Must be between 0 and " << n - 1 << std::endl;
+                console.report_failure();
+                return;
+            }
+        }
 
-        if (start_v < 0 || start_v >= n) {
-            std::cout << "Invalid start vertex. Must be between 0 and " << n - 1 << std::endl;
+        if (sources.size() > 1) {
+            const auto nearest = dispatch_policies([](auto weight, auto) {
+                return &find_nearest_sources<decltype(weight)>;
+            });
+            std::string description = "find";
+            for (const int v : sources) description += " " + std::to_string(v);
+
+            run_job(description + " on " + workspace.current_name(),
+                    [snapshot = graph, sources, nearest](std::ostream& out, CancelToken& token) {
+                token.set_total(1);
+                print_nearest_sources(nearest(*snapshot, sources, &token), out);
+                token.advance();
+            }, background);
             return;
         }
 
-        std::cout << "BFS traversal order: ";
-        const std::vector<int> distances = find_distances(*graph, start_v);
-        std::cout << std::endl;
-        print_distances(distances, start_v);
+        const int start_v = sources.front();
+
+        if (tree) {
+            // The tree comes from the same traversal as the distances; cached rows hold no parents
+            const auto search = dispatch_policies([](auto weight, auto) { return &find_distances<decltype(weight)>; });
+            run_job("find --tree " + std::to_string(start_v) + " on " + workspace.current_name(),
+                    [snapshot = graph, start_v, search](std::ostream& out, CancelToken& token) {
+                token.set_total(1);
+                std::ostringstream order;
+                std::vector<int> parents;
+                const std::vector<int> distances = search(*snapshot, start_v, &order, &token, &parents);
+                out << "BFS traversal order: " << order.str() << std::endl;
+                print_distance_tree(distances, parents, start_v, out);
+                token.advance();
+            }, background);
+            return;
+        }
+
+        const std::uint64_t version = workspace.version(workspace.current_name());
+        if (const auto cached = cache.find_row(version, start_v)) {
+            write_find(*cached, start_v, std::cout);
+            return;
+        }
+
+        const auto search = dispatch_policies([](auto weight, auto) { return &find_distances<decltype(weight)>; });
+
+        run_job("find " + std::to_string(start_v) + " on " + workspace.current_name(),
+                [snapshot = graph, version, start_v, search, &results = cache](std::ostream& out, CancelToken& token) {
+            token.set_total(1);
+            std::ostringstream order;
+            CachedRow row;
+            row.distances = search(*snapshot, start_v, &order, &token, nullptr);
+            row.order = order.str();
+            write_find(row, start_v, out);
+            results.store_row(version, start_v, std::move(row));
+            token.advance();
+        }, background);
     } catch (const std::exception& e) {
         std::cout << "Error in BFS: " << e.what() << std::endl;
-        std::cout << "Usage: find [start_v]" << std::endl;
+        std::cout << "Usage: find [--tree] [start_v ...] [&]" << std::endl;
+        console.report_failure();
     }
 }
 
-void GraphConsoleAdapter::cmd_analyse() const {
-    if (!graphs_created) {
-        std::cout << "No graphs created. Use 'create' command first." << std::endl;
-        return;
-    }
+void GraphConsoleAdapter::cmd_dist(Console::CommandArgs args) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const int n = graph->n;
 
     try {
-        std::cout << "=== GRAPH ANALYSIS ===" << std::endl;
+        const bool background = strip_background_flag(args);
+
+        // Landmark queries: "~u v" bounds the distance, "--alt u v" computes it exactly
+        const bool alt = args.size() == 3 && args[0] == "--alt";
+        if (alt || (args.size() == 2 && args[0].starts_with('~'))) {
+            const int u = Console::parse_int(alt ? args[1] : args[0].substr(1));
+            const int v = Console::parse_int(args.back());
+            if (u < 0 || u >= n || v < 0 || v >= n) {
+                std::cout << "Invalid vertex. Must be between 0 and " << n - 1 << std::endl;
+                console.report_failure();
+                return;
+            }
+            landmark_distance(*graph, u, v, alt);
+            return;
+        }
+        if (args.size() != 2) throw std::invalid_argument("expected two arguments");
 
-        SILENCE_COUT_BEGIN
-        const auto dist_matrix = build_distance_matrix(*graph);
-        SILENCE_COUT_END
-        print_distance_matrix(dist_matrix);
+        const auto point = dispatch_policies([](auto weight, auto) { return &point_distance<decltype(weight)>; });
+        const auto reverse = incoming_adjacency(*graph);
 
-        const auto ecc = compute_eccentricities(dist_matrix);
+        if (args[0] == "--file") {
+            const std::string path(args[1]);
+            std::vector<std::pair<int, int>> pairs = read_vertex_pairs(path, n);
 
-        std::cout << "\nEccentricities:" << std::endl;
-        for (int i = 0; i < static_cast<int>(ecc.size()); i++) {
-            std::cout << "Vertex " << i << ": ";
-            if (ecc[i] == -1) {
-                std::cout << "inf (isolated)";
-            } else {
-                std::cout << ecc[i];
+            run_job("dist --file " + path + " on " + workspace.current_name(),
+                    [snapshot = graph, reverse, point, labels = current_hub_labels(), pairs = std::move(pairs)](
+                        std::ostream& out, CancelToken& token) {
+                token.set_total(pairs.size());
+                SearchWorkspace search;
+                std::size_t touched = 0;
+                std::size_t unreachable = 0;
+                const auto start = std::chrono::steady_clock::now();
+                for (const auto& [u, v] : pairs) {
+                    const PointDistance result = labels != nullptr ? PointDistance{hub_distance(*labels, u, v), 0}
+                                                                   : point(*snapshot, u, v, reverse.get(), search, &token);
+                    out << u << " " << v << " " << result.distance << '\n';
+                    touched += result.touched;
+                    if (result.distance == -1) unreachable++;
+                    token.advance();
+                }
+                const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+                out << pairs.size() << " pairs, " << unreachable << " unreachable, ";
+                if (labels != nullptr) out << "answered from hub labels, ";
+                else {
+                    out << format_fixed(pairs.empty() ? 0.0 : static_cast<double>(touched) / static_cast<double>(pairs.size()), 2)
+                        << " of " << snapshot->n << " vertices searched per pair, ";
+                }
+                out << format_fixed(elapsed.count(), 2) << " ms" << std::endl;
+            }, background);
+            return;
+        }
+
+        const int u = Console::parse_int(args[0]);
+        const int v = Console::parse_int(args[1]);
+        if (u < 0 || u >= n || v < 0 || v >= n) {
+            std::cout << "Invalid vertex. Must be between 0 and " << n - 1 << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        if (const auto labels = current_hub_labels()) {
+            const auto start = std::chrono::steady_clock::now();
+            const int distance = hub_distance(*labels, u, v);
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+            if (distance == -1) std::cout << "Vertex " << v << " is unreachable from " << u;
+            else std::cout << "Distance from " << u << " to " << v << ": " << distance;
+            std::cout << " (hub labels, " << format_fixed(elapsed.count(), 3) << " ms)" << std::endl;
+            return;
+        }
+
+        // Rows cached by find hold BFS-tree distances, which are the shortest ones only without weights
+        if (!weighted) {
+            if (const auto cached = cache.find_distance(workspace.version(workspace.current_name()), u, v)) {
+                if (*cached == -1) std::cout << "Vertex " << v << " is unreachable from " << u << " (cached)" << std::endl;
+                else std::cout << "Distance from " << u << " to " << v << ": " << *cached << " (cached)" << std::endl;
+                return;
             }
-            std::cout << std::endl;
         }
 
-        const int radius = compute_radius(ecc);
-        const int diameter = compute_diameter(ecc);
+        const auto start = std::chrono::steady_clock::now();
+        const PointDistance result = point(*graph, u, v, reverse.get(), point_workspace, nullptr);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        if (result.distance == -1) std::cout << "Vertex " << v << " is unreachable from " << u;
+        else std::cout << "Distance from " << u << " to " << v << ": " << result.distance;
+        std::cout << " (searched " << result.touched << " of " << n << " vertices in "
+                  << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error in dist: " << e.what() << std::endl;
+        std::cout << "Usage: dist <u> <v> | dist ~<u> <v> | dist --alt <u> <v> | dist --file <pairs> [&]" << std::endl;
+        console.report_failure();
+    }
+}
 
-        const auto central = find_central_vertices(ecc, radius);
-        const auto peripheral = find_peripheral_vertices(ecc, diameter);
+void GraphConsoleAdapter::landmark_distance(const Graph &graph, const int u, const int v, const bool exact) {
+    const auto table = current_landmarks();
+    if (table == nullptr) return;
 
-        std::cout << "\n=== RESULTS ===" << std::endl;
-        std::cout << "Radius: " << (radius == -1 ? "inf (graph is disconnected)" : std::to_string(radius)) << std::endl;
-        std::cout << "Diameter: " << (radius == -1 ? "inf (graph is disconnected)" : std::to_string(diameter)) << std::endl;
+    const auto start = std::chrono::steady_clock::now();
+    if (exact) {
+        const auto alt = dispatch_policies([](auto weight, auto) { return &alt_distance<decltype(weight)>; });
+        const PointDistance result = alt(graph, *table, u, v, point_workspace, nullptr);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
 
-        std::cout << "Central vertices (eccentricity == radius): ";
-        if (central.empty()) std::cout << "none";
-        else for (const int v : central) std::cout << v << " ";
-        std::cout << std::endl;
+        if (result.distance == -1) std::cout << "Vertex " << v << " is unreachable from " << u;
+        else std::cout << "Distance from " << u << " to " << v << ": " << result.distance;
+        std::cout << " (ALT, searched " << result.touched << " of " << graph.n << " vertices in "
+                  << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+        return;
+    }
+
+    const DistanceBounds bounds = landmark_bounds(*table, internal_vertex(graph, u), internal_vertex(graph, v));
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    if (bounds.unreachable) std::cout << "Vertex " << v << " is unreachable from " << u;
+    else if (bounds.lower == bounds.upper) std::cout << "Distance from " << u << " to " << v << ": " << bounds.upper;
+    else if (bounds.upper == -1) std::cout << "Distance from " << u << " to " << v << ": at least " << bounds.lower;
+    else std::cout << "Distance from " << u << " to " << v << ": between " << bounds.lower << " and " << bounds.upper;
+    std::cout << " (" << table->k << " landmarks, " << format_fixed(elapsed.count(), 3) << " ms)" << std::endl;
+}
+
+std::shared_ptr<const LandmarkTable> GraphConsoleAdapter::current_landmarks() const {
+    if (landmark_table == nullptr || landmark_version != workspace.version(workspace.current_name())) {
+        std::cout << "No landmarks for graph '" << workspace.current_name() << "'. Use 'landmarks build <k>' first."
+                  << std::endl;
+        console.report_failure();
+        return nullptr;
+    }
+    return landmark_table;
+}
+
+void GraphConsoleAdapter::cmd_landmarks(Console::CommandArgs args) {
+    const char* usage = "Usage: landmarks [build <k> [degree|random|farthest] | clear]";
 
-        std::cout << "Peripheral vertices (eccentricity == diameter): ";
-        if (peripheral.empty()) std::cout << "none";
-        else for (const int v : peripheral) std::cout << v << " ";
+    if (args.size() == 1 && args[0] == "clear") {
+        landmark_table.reset();
+        landmark_version = 0;
+        std::cout << "Landmarks cleared" << std::endl;
+        return;
+    }
+
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+
+    if (args.empty()) {
+        const auto table = current_landmarks();
+        if (table == nullptr) return;
+        std::cout << table->k << " landmarks (" << landmark_strategy_name(table->strategy) << "), "
+                  << format_bytes(table->tracked.size()) << ":";
+        for (const int landmark : table->landmarks) std::cout << " " << original_vertex(*graph, landmark);
         std::cout << std::endl;
+        return;
+    }
+
+    try {
+        if (args[0] != "build" || args.size() < 2 || args.size() > 3) throw std::invalid_argument("unknown arguments");
+        const int k = std::min(Console::parse_int(args[1]), graph->n);
+        if (k < 1) throw std::invalid_argument("number of landmarks must be positive");
+        LandmarkStrategy strategy = LandmarkStrategy::Farthest;
+        if (args.size() == 3 && !parse_landmark_strategy(args[2], strategy)) {
+            throw std::invalid_argument("unknown strategy '" + std::string(args[2]) + "'");
+        }
+
+        const std::size_t footprint = estimate_landmark_footprint(graph->n, k, directed);
+        const std::size_t releasing = landmark_table != nullptr ? landmark_table->tracked.size() : 0;
+        if (!memory_budget_allows(footprint, releasing)) {
+            std::cout << "Refusing to build landmarks: table needs " << format_bytes(footprint) << ", memory budget is "
+                      << format_bytes(get_memory_budget()) << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        const auto build = dispatch_policies([](auto weight, auto direction) {
+            return &build_landmarks<decltype(weight), decltype(direction)>;
+        });
+        const unsigned int threads = analysis_options.threads;
+
+        // Built in the foreground: the table is handed over once the job has finished, and the
+        // previous one is kept if the build fails or is cancelled
+        auto built = std::make_shared<std::shared_ptr<const LandmarkTable>>();
+        run_job("landmarks build " + std::to_string(k) + " " + landmark_strategy_name(strategy) + " on "
+                + workspace.current_name(),
+                [snapshot = graph, build, k, strategy, threads, built](std::ostream& out, CancelToken& token) {
+            const auto start = std::chrono::steady_clock::now();
+            *built = build(*snapshot, k, strategy, threads, 0, &token);
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+            out << "Built " << k << " landmarks (" << landmark_strategy_name(strategy) << "), "
+                << format_bytes((*built)->tracked.size()) << " (" << format_fixed(elapsed.count(), 2) << " ms)"
+                << std::endl;
+        }, false);
+
+        if (*built != nullptr) {
+            landmark_table = std::move(*built);
+            landmark_version = workspace.version(workspace.current_name());
+        }
     } catch (const std::exception& e) {
-        std::cout << "Error in ANALYSIS: " << e.what() << std::endl;
+        std::cout << "Error in landmarks: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+std::shared_ptr<const HubLabels> GraphConsoleAdapter::current_hub_labels() const {
+    if (hub_labels == nullptr || hub_labels_version != workspace.version(workspace.current_name())) return nullptr;
+    return hub_labels;
+}
+
+void GraphConsoleAdapter::cmd_labels(Console::CommandArgs args) {
+    const char* usage = "Usage: labels [build | save <file> | load <file> | clear]";
+
+    if (args.size() == 1 && args[0] == "clear") {
+        hub_labels.reset();
+        hub_labels_version = 0;
+        std::cout << "Hub labels cleared" << std::endl;
+        return;
     }
+
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+
+    try {
+        if (args.empty()) {
+            const auto labels = current_hub_labels();
+            if (labels == nullptr) {
+                std::cout << "No hub labels for graph '" << workspace.current_name()
+                          << "'. Use 'labels build' or 'labels load <file>' first." << std::endl;
+                console.report_failure();
+                return;
+            }
+            std::cout << "Hub labels: " << format_fixed(labels->average_label_size(), 1)
+                      << " hubs per label, " << format_bytes(labels->tracked.size()) << std::endl;
+            return;
+        }
+
+        if (args.size() == 1 && args[0] == "build") {
+            const auto build = dispatch_policies([](auto weight, auto direction) {
+                return &build_hub_labels<decltype(weight), decltype(direction)>;
+            });
+
+            // Built in the foreground: the labels are handed over once the job has finished, and the
+            // previous ones are kept if the build exceeds the budget or is cancelled
+            auto built = std::make_shared<std::shared_ptr<const HubLabels>>();
+            run_job("labels build on " + workspace.current_name(),
+                    [snapshot = graph, build, built](std::ostream& out, CancelToken& token) {
+                const auto start = std::chrono::steady_clock::now();
+                *built = build(*snapshot, &token);
+                const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+                out << "Built hub labels: " << format_fixed((*built)->average_label_size(), 1)
+                    << " hubs per label, " << format_bytes((*built)->tracked.size()) << " ("
+                    << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+            }, false);
+
+            if (*built != nullptr) {
+                hub_labels = std::move(*built);
+                hub_labels_version = workspace.version(workspace.current_name());
+            }
+            return;
+        }
+
+        if (args.size() != 2) throw std::invalid_argument("unknown arguments");
+        const std::string path(args[1]);
+
+        if (args[0] == "save") {
+            const auto labels = current_hub_labels();
+            if (labels == nullptr) throw std::runtime_error("no hub labels for graph '" + workspace.current_name() + "'");
+            save_hub_labels(*labels, path);
+            std::cout << "Hub labels saved to " << path << std::endl;
+            return;
+        }
+        if (args[0] != "load") throw std::invalid_argument("unknown arguments");
+
+        auto labels = load_hub_labels(path);
+        if (labels->n != graph->n || labels->directed != directed || labels->weighted != weighted
+            || labels->fingerprint != graph_fingerprint(*graph)) {
+            throw std::runtime_error("'" + path + "' was built for a different graph");
+        }
+        hub_labels = std::move(labels);
+        hub_labels_version = workspace.version(workspace.current_name());
+        std::cout << "Hub labels loaded from " << path << ": " << format_fixed(hub_labels->average_label_size(), 1)
+                  << " hubs per label" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error in labels: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_reach(Console::CommandArgs args) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const int n = graph->n;
+
+    try {
+        if (args.size() != 2) throw std::invalid_argument("expected two arguments");
+
+        std::vector<std::pair<int, int>> pairs;
+        if (args[0] == "--file") {
+            pairs = read_vertex_pairs(std::string(args[1]), n);
+        } else {
+            const int u = Console::parse_int(args[0]);
+            const int v = Console::parse_int(args[1]);
+            if (u < 0 || u >= n || v < 0 || v >= n) {
+                std::cout << "Invalid vertex. Must be between 0 and " << n - 1 << std::endl;
+                console.report_failure();
+                return;
+            }
+            pairs.emplace_back(u, v);
+        }
+
+        const bool built = reachability == nullptr
+                           || reachability_version != workspace.version(workspace.current_name());
+        const auto build_start = std::chrono::steady_clock::now();
+        const auto index = reachability_index(*graph);
+        if (index == nullptr) {
+            console.report_failure();
+            return;
+        }
+        if (built) {
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start);
+            std::cout << "Built reachability index: " << index->count << (directed ? " strongly connected" : "")
+                      << " components, " << format_bytes(index->tracked.size()) << " ("
+                      << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+        }
+
+        if (pairs.size() == 1) {
+            const auto [u, v] = pairs.front();
+            const bool reachable = index->reaches(internal_vertex(*graph, u), internal_vertex(*graph, v));
+            std::cout << "Vertex " << v << (reachable ? " is reachable from " : " is unreachable from ") << u << std::endl;
+            return;
+        }
+
+        std::size_t reachable = 0;
+        for (const auto& [u, v] : pairs) {
+            const bool found = index->reaches(internal_vertex(*graph, u), internal_vertex(*graph, v));
+            std::cout << u << " " << v << " " << (found ? 1 : 0) << '\n';
+            if (found) reachable++;
+        }
+        std::cout << pairs.size() << " pairs, " << reachable << " reachable" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error in reach: " << e.what() << std::endl;
+        std::cout << "Usage: reach <u> <v> | reach --file <pairs>" << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_path(Console::CommandArgs args) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const int n = graph->n;
+
+    try {
+        if (args.size() != 2) throw std::invalid_argument("expected two arguments");
+        const int u = Console::parse_int(args[0]);
+        const int v = Console::parse_int(args[1]);
+        if (u < 0 || u >= n || v < 0 || v >= n) {
+            std::cout << "Invalid vertex. Must be between 0 and " << n - 1 << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        std::vector<int> vertices;
+        int distance;
+        std::string source;
+        const auto start = std::chrono::steady_clock::now();
+        if (const auto cached = cache.find_analysis(workspace.version(workspace.current_name()));
+            cached != nullptr && cached->shortest_paths) {
+            // The cached matrix gives every first hop, so no search is needed
+            vertices = path_from_distances(*graph, *cached, u, v);
+            distance = distance_row(*cached, u)[v];
+            source = "from cached analysis";
+        } else {
+            const auto find_path = dispatch_policies([](auto weight, auto) { return &point_path<decltype(weight)>; });
+            PointPath found = find_path(*graph, u, v, incoming_adjacency(*graph).get(), point_workspace, nullptr);
+            vertices = std::move(found.vertices);
+            distance = found.distance;
+            source = "searched " + std::to_string(found.touched) + " of " + std::to_string(n) + " vertices";
+        }
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        if (distance == -1) {
+            std::cout << "Vertex " << v << " is unreachable from " << u;
+        } else {
+            std::cout << "Path from " << u << " to " << v << " (distance " << distance << "): ";
+            for (std::size_t i = 0; i < vertices.size(); i++) std::cout << (i == 0 ? "" : " -> ") << vertices[i];
+        }
+        std::cout << " (" << source << ", " << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error in path: " << e.what() << std::endl;
+        std::cout << "Usage: path <u> <v>" << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_neighbourhood(Console::CommandArgs args, const bool hops) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const int n = graph->n;
+    const char* usage = hops ? "Usage: ball <v> <k>" : "Usage: within <v> <dist>";
+
+    try {
+        if (args.size() != 2) throw std::invalid_argument("expected two arguments");
+        const int v = Console::parse_int(args[0]);
+        const int limit = Console::parse_int(args[1]);
+        if (v < 0 || v >= n) {
+            std::cout << "Invalid vertex. Must be between 0 and " << n - 1 << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        // ball always counts edges; within follows the weights of weighted graphs
+        const auto search = hops ? &bounded_search<Unweighted>
+                                 : dispatch_policies([](auto weight, auto) { return &bounded_search<decltype(weight)>; });
+
+        const auto start = std::chrono::steady_clock::now();
+        const Neighbourhood hood = search(*graph, v, limit, point_workspace, nullptr);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        std::cout << hood.vertices.size() << " vertices within " << (hops ? "" : "distance ") << limit
+                  << (hops ? " hops" : "") << " of vertex " << v << " (" << format_fixed(elapsed.count(), 2)
+                  << " ms):" << std::endl;
+        for (std::size_t i = 0; i < hood.vertices.size(); i++) {
+            std::cout << "Vertex " << hood.vertices[i] << ": " << hood.distances[i] << '\n';
+        }
+        std::cout << std::flush;
+    } catch (const std::exception& e) {
+        std::cout << "Error in " << (hops ? "ball" : "within") << ": " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_analyse(Console::CommandArgs args) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const int n = graph->n;
+
+    const bool background = strip_background_flag(args);
+
+    AnalysisOptions options = analysis_options;
+    if (args.size() == 2 && args[0] == "--out-of-core") {
+        options.matrix_file = args[1];
+    } else if (!args.empty()) {
+        std::cout << "Usage: analyse [--out-of-core <file>] [&]" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    // A cached result, spilled or not, is printed again; only an explicit --out-of-core rewrites the matrix
+    const std::uint64_t version = workspace.version(workspace.current_name());
+    if (options.matrix_file.empty()) {
+        if (const auto cached = cache.find_analysis(version)) {
+            write_analysis(*cached, std::cout);
+            return;
+        }
+    }
+
+    if (const std::size_t footprint = estimate_distance_matrix_footprint(n);
+        options.matrix_file.empty() && !memory_budget_allows(footprint)) {
+        if (spill_dir.empty()) {
+            std::cout << "Refusing to analyse: distance matrix needs " << format_bytes(footprint)
+                      << ", memory budget is " << format_bytes(get_memory_budget()) << std::endl;
+            std::cout << "Use 'analyse --out-of-core <file>' or set spill_dir in [performance]" << std::endl;
+            console.report_failure();
+            return;
+        }
+        // Over budget: keep the matrix on disk in a temporary file that goes away with the cached result
+        options.matrix_file = (fs::path(spill_dir) / ("distances-" + workspace.current_name() + "-"
+                                                      + std::to_string(version) + ".gdm")).string();
+        options.keep_matrix_file = false;
+        std::cout << "Distance matrix exceeds memory budget, keeping it on disk in " << spill_dir << std::endl;
+    }
+
+    if (!options.matrix_file.empty()) {
+        std::error_code error;
+        const fs::path directory = fs::absolute(options.matrix_file, error).parent_path();
+        const fs::space_info space = fs::space(directory, error);
+        if (const std::size_t bytes = DistanceMatrixFile::file_bytes(n); !error && space.available < bytes) {
+            std::cout << "Refusing to analyse: distance matrix file needs " << format_bytes(bytes) << ", only "
+                      << format_bytes(space.available) << " free in " << directory.string() << std::endl;
+            console.report_failure();
+            return;
+        }
+    }
+
+    // Directed searches may reach only part of their component; the index tells them when to stop.
+    // A missing index is built inside the job, so it is cancellable and does not block 'analyse &';
+    // the job holds the index, so dropping it from the adapter cannot free it mid-analysis.
+    std::shared_ptr<const ReachabilityIndex> index;
+    if (directed && reachability != nullptr && reachability_version == version) index = reachability;
+    const bool build_index = directed && index == nullptr;
+    const std::size_t releasing = reachability != nullptr ? reachability->tracked.size() : 0;
+
+    const auto analyse = dispatch_policies([](auto weight, auto) { return &analyse_graph<decltype(weight)>; });
+
+    // In the foreground the new index is handed over once the job has finished
+    auto built = std::make_shared<std::shared_ptr<const ReachabilityIndex>>();
+    run_job("analyse " + workspace.current_name(),
+            [snapshot = graph, version, analyse, options, index, build_index, releasing, built,
+             &results = cache](std::ostream& out, CancelToken& token) mutable {
+        if (build_index) {
+            index = build_index_within_budget(*snapshot, true, releasing, out, &token);
+            *built = index;
+        }
+        options.reachability = index.get();
+        auto result = std::make_shared<const AnalysisResult>(analyse(*snapshot, &token, options));
+        write_analysis(*result, out);
+        results.store_analysis(version, std::move(result));
+    }, background);
+
+    if (!background && *built != nullptr) {
+        reachability = std::move(*built);
+        reachability_version = version;
+    }
+}
+
+void GraphConsoleAdapter::cmd_snapshot(Console::CommandArgs args) {
+    const char* usage = "Usage: snapshot save <file> [&] | snapshot load <file> [name] [--verify]";
+
+    try {
+        const bool background = strip_background_flag(args);
+        if (args.size() < 2 || (args[0] != "save" && args[0] != "load")) throw std::invalid_argument("unknown arguments");
+        const std::string path(args[1]);
+
+        if (args[0] == "save") {
+            if (args.size() != 2) throw std::invalid_argument("unknown arguments");
+            const auto graph = require_graph();
+            if (graph == nullptr) return;
+
+            // Without a cached analysis the snapshot holds the graph alone
+            const auto analysis = cache.find_analysis(workspace.version(workspace.current_name()));
+            if (analysis == nullptr) {
+                std::cout << "No analysis of '" << workspace.current_name() << "' cached, saving the graph only"
+                          << std::endl;
+            }
+            run_job("snapshot save " + path,
+                    [snapshot = graph, analysis, path, directed = directed, weighted = weighted](
+                        std::ostream& out, CancelToken& token) {
+                const auto start = std::chrono::steady_clock::now();
+                save_snapshot(path, *snapshot, directed, weighted, analysis.get(), &token);
+                const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+                out << "Snapshot saved to " << path << " (" << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+            }, background);
+            return;
+        }
+
+        if (background) throw std::invalid_argument("snapshot load runs in the foreground");
+        std::string name = workspace.empty() ? default_graph_name : workspace.current_name();
+        bool verify = false;
+        for (const auto& arg : args.subspan(2)) {
+            if (arg == "--verify") verify = true;
+            else if (GraphWorkspace::is_valid_name(std::string(arg))) name = arg;
+            else throw std::invalid_argument("invalid graph name '" + std::string(arg) + "'");
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        Snapshot snapshot = load_snapshot(path, dense_matrix_limit, verify);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        if (snapshot.directed != directed || snapshot.weighted != weighted) {
+            throw std::runtime_error("'" + path + "' holds a " + (snapshot.weighted ? "weighted " : "unweighted ")
+                                     + (snapshot.directed ? "directed" : "undirected") + " graph, which this console "
+                                     + "does not work with");
+        }
+
+        const int n = snapshot.graph->n;
+        workspace.drop(name);
+        const std::uint64_t version = workspace.put(name, std::move(snapshot.graph));
+        workspace.use(name);
+        prune_cache();
+        if (snapshot.analysis != nullptr) cache.store_analysis(version, std::move(snapshot.analysis));
+
+        std::cout << "Loaded graph '" << name << "' with " << n << " vertices from " << path
+                  << (cache.find_analysis(version) != nullptr ? ", analysis restored" : "") << " ("
+                  << format_fixed(elapsed.count(), 2) << " ms)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error in snapshot: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::write_find(const CachedRow &row, const int start_v, std::ostream &out) {
+    out << "BFS traversal order: ";
+    if (row.order.empty()) out << "(served from analysis cache)" << std::endl;
+    else out << row.order;
+    out << std::endl;
+    print_distances(row.distances, start_v, out);
+}
+
+void GraphConsoleAdapter::write_analysis(const AnalysisResult &result, std::ostream &out) {
+    out << "=== GRAPH ANALYSIS ===" << std::endl;
+    if (result.dist_file != nullptr) {
+        out << "Distance matrix file: " << result.dist_file->path() << std::endl;
+        print_distance_matrix(*result.dist_file, out);
+    } else {
+        print_distance_matrix(result.dist_matrix, out);
+    }
+
+    const auto& ecc = result.eccentricities;
+
+    out << "\nEccentricities:" << std::endl;
+    for (int i = 0; i < static_cast<int>(ecc.size()); i++) {
+        out << "Vertex " << i << ": ";
+        if (ecc[i] == -1) {
+            out << "inf (isolated)";
+        } else {
+            out << ecc[i];
+        }
+        out << '\n';
+    }
+
+    const int radius = result.radius;
+    const int diameter = result.diameter;
+    const auto& central = result.central;
+    const auto& peripheral = result.peripheral;
+
+    out << "\n=== RESULTS ===" << std::endl;
+    out << "Radius: " << (radius == -1 ? "inf (graph is disconnected)" : std::to_string(radius)) << std::endl;
+    out << "Diameter: " << (radius == -1 ? "inf (graph is disconnected)" : std::to_string(diameter)) << std::endl;
+
+    out << "Central vertices (eccentricity == radius): ";
+    if (central.empty()) out << "none";
+    else for (const int v : central) out << v << " ";
+    out << std::endl;
+
+    out << "Peripheral vertices (eccentricity == diameter): ";
+    if (peripheral.empty()) out << "none";
+    else for (const int v : peripheral) out << v << " ";
+    out << std::endl;
+
+    if (result.components.count > 1) {
+        out << "\n=== COMPONENTS ===" << std::endl;
+        for (int id = 0; id < result.components.count; id++) {
+            const ComponentSummary& summary = result.component_summary[id];
+            out << "Component " << id << " (" << summary.size << " vertices, first " << result.components.members[id].front() << "): ";
+            if (summary.radius == -1) out << "radius inf, diameter inf" << std::endl;
+            else out << "radius " << summary.radius << ", diameter " << summary.diameter << std::endl;
+        }
+    }
+}
+
+void GraphConsoleAdapter::cmd_centrality(Console::CommandArgs args) {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    const char* usage = "Usage: centrality <closeness|harmonic|betweenness> [--sample <k>] [--top <k>] [&]";
+
+    try {
+        const bool background = strip_background_flag(args);
+        CentralityMeasure measure;
+        if (args.empty() || !parse_centrality_measure(args[0], measure)) {
+            throw std::invalid_argument("expected closeness, harmonic or betweenness");
+        }
+
+        CentralityOptions options;
+        options.threads = analysis_options.threads;
+        int top = 10;
+        for (std::size_t i = 1; i < args.size(); i += 2) {
+            if (i + 1 >= args.size()) throw std::invalid_argument("missing value for " + std::string(args[i]));
+            const int value = Console::parse_int(args[i + 1]);
+            if (value <= 0) throw std::invalid_argument(std::string(args[i]) + " must be positive");
+            if (args[i] == "--sample") options.samples = value;
+            else if (args[i] == "--top") top = value;
+            else throw std::invalid_argument("unknown option " + std::string(args[i]));
+        }
+
+        const auto compute = dispatch_policies([](auto weight, auto direction) {
+            return &compute_centrality<decltype(weight), decltype(direction)>;
+        });
+
+        std::string description = std::string("centrality ") + centrality_measure_name(measure);
+        if (options.samples > 0) description += " --sample " + std::to_string(options.samples);
+
+        run_job(description + " on " + workspace.current_name(),
+                [snapshot = graph, measure, options, top, compute](std::ostream& out, CancelToken& token) {
+            const std::vector<double> centrality = compute(*snapshot, measure, options, &token);
+
+            std::vector<int> ranking(centrality.size());
+            std::iota(ranking.begin(), ranking.end(), 0);
+            const auto shown = std::min<std::size_t>(top, ranking.size());
+            std::partial_sort(ranking.begin(), ranking.begin() + static_cast<std::ptrdiff_t>(shown), ranking.end(),
+                              [&](const int a, const int b) {
+                                  return centrality[a] != centrality[b] ? centrality[a] > centrality[b] : a < b;
+                              });
+
+            out << "Top " << shown << " vertices by " << centrality_measure_name(measure) << " centrality";
+            if (options.samples > 0 && options.samples < snapshot->n) {
+                out << " (estimated from " << options.samples << " sources)";
+            }
+            out << ":" << std::endl;
+            for (std::size_t i = 0; i < shown; i++) {
+                out << i + 1 << ". Vertex " << ranking[i] << ": " << centrality[ranking[i]] << '\n';
+            }
+            out << std::flush;
+        }, background);
+    } catch (const std::exception& e) {
+        std::cout << "Error in centrality: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_components() const {
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+
+    ComponentInfo info = directed ? find_strong_components(*graph) : find_connected_components(*graph);
+    if (!graph->original_id.empty()) info = relabel_components(info, graph->original_id);
+    std::cout << (directed ? "Strongly connected components: " : "Connected components: ") << info.count << std::endl;
+
+    constexpr std::size_t max_listed = 20;
+    for (int id = 0; id < info.count; id++) {
+        const auto& members = info.members[id];
+        std::cout << "Component " << id << " (" << members.size() << " vertices): ";
+        for (std::size_t i = 0; i < members.size() && i < max_listed; i++) std::cout << members[i] << " ";
+        if (members.size() > max_listed) std::cout << "...";
+        std::cout << std::endl;
+    }
+}
+
+void GraphConsoleAdapter::cmd_stats(Console::CommandArgs args) const {
+    if (args.size() != 1 || args[0] != "graph") {
+        std::cout << "Usage: stats graph" << std::endl;
+        console.report_failure();
+        return;
+    }
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+
+    const auto compute = dispatch_policies([](auto, auto direction) {
+        return &compute_graph_stats<decltype(direction)>;
+    });
+    const auto start = std::chrono::steady_clock::now();
+    const GraphStats stats = compute(*graph);
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Graph '" << workspace.current_name() << "' (" << format_fixed(elapsed.count(), 2) << " ms)"
+              << std::endl;
+    print_graph_stats(stats, std::cout);
+}
+
+std::shared_ptr<const Graph> GraphConsoleAdapter::require_graph() const {
+    auto graph = workspace.current_graph();
+    if (graph == nullptr) {
+        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.report_failure();
+    }
+    return graph;
+}
+
+void GraphConsoleAdapter::cmd_use(Console::CommandArgs args) {
+    if (args.empty()) {
+        std::cout << "Usage: use <name>" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    if (!workspace.use(std::string(args[0]))) {
+        std::cout << "No graph named '" << args[0] << "'. Use 'list' to see graphs." << std::endl;
+        console.report_failure();
+        return;
+    }
+    std::cout << "Current graph: " << workspace.current_name() << std::endl;
+}
+
+void GraphConsoleAdapter::cmd_list() const {
+    const auto entries = workspace.list();
+    if (entries.empty()) {
+        std::cout << "Workspace is empty. Use 'create' command first." << std::endl;
+        return;
+    }
+
+    std::cout << std::left << "  " << std::setw(16) << "NAME" << std::setw(10) << "VERTICES"
+              << std::setw(12) << "MEMORY" << "OWNERS" << std::endl;
+    for (const auto& entry : entries) {
+        std::cout << (entry.current ? "* " : "  ") << std::setw(16) << entry.name << std::setw(10) << entry.n
+                  << std::setw(12) << format_bytes(entry.bytes) << entry.owners << std::endl;
+    }
+    std::cout << std::right;
+}
+
+void GraphConsoleAdapter::cmd_drop(Console::CommandArgs args) {
+    if (args.empty()) {
+        std::cout << "Usage: drop <name>" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    if (!workspace.drop(std::string(args[0]))) {
+        std::cout << "No graph named '" << args[0] << "'" << std::endl;
+        console.report_failure();
+        return;
+    }
+    prune_cache();
+    std::cout << "Dropped graph '" << args[0] << "'" << std::endl;
+}
+
+void GraphConsoleAdapter::cmd_clone(Console::CommandArgs args) {
+    if (args.empty() || args.size() > 2) {
+        std::cout << "Usage: clone [source] <name>" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    const std::string source = args.size() == 2 ? std::string(args[0]) : workspace.current_name();
+    const std::string name(args.back());
+
+    if (!GraphWorkspace::is_valid_name(name)) {
+        std::cout << "Invalid graph name '" << name << "'. Names start with a letter and use letters, digits, '_' or '-'" << std::endl;
+        console.report_failure();
+        return;
+    }
+    if (!workspace.clone(source, name)) {
+        std::cout << "No graph named '" << source << "'" << std::endl;
+        console.report_failure();
+        return;
+    }
+    std::cout << "Graph '" << name << "' now shares the snapshot of '" << source << "'" << std::endl;
+}
+
+void GraphConsoleAdapter::prune_cache() {
+    std::vector<std::uint64_t> live_versions;
+    for (const auto& entry : workspace.list()) live_versions.push_back(entry.version);
+    cache.prune(live_versions);
+
+    if (std::ranges::find(live_versions, reverse_version) == live_versions.end()) {
+        reverse_adjacency.reset();
+        reverse_version = 0;
+    }
+    if (std::ranges::find(live_versions, reachability_version) == live_versions.end()) {
+        reachability.reset();
+        reachability_version = 0;
+    }
+    if (std::ranges::find(live_versions, landmark_version) == live_versions.end()) {
+        landmark_table.reset();
+        landmark_version = 0;
+    }
+    if (std::ranges::find(live_versions, hub_labels_version) == live_versions.end()) {
+        hub_labels.reset();
+        hub_labels_version = 0;
+    }
+}
+
+std::shared_ptr<const ReverseAdjacency> GraphConsoleAdapter::incoming_adjacency(const Graph &graph) {
+    if (!directed) return nullptr;
+
+    const std::uint64_t version = workspace.version(workspace.current_name());
+    if (reverse_adjacency == nullptr || reverse_version != version) {
+        reverse_adjacency = build_reverse_adjacency(graph);
+        reverse_version = version;
+    }
+    return reverse_adjacency;
+}
+
+std::shared_ptr<const ReachabilityIndex> GraphConsoleAdapter::reachability_index(const Graph &graph) {
+    const std::uint64_t version = workspace.version(workspace.current_name());
+    if (reachability != nullptr && reachability_version == version) return reachability;
+
+    auto index = build_index_within_budget(graph, directed, reachability != nullptr ? reachability->tracked.size() : 0,
+                                           std::cout, nullptr);
+    if (index == nullptr) return nullptr;
+    reachability = std::move(index);
+    reachability_version = version;
+    return reachability;
+}
+
+void GraphConsoleAdapter::cmd_cache(Console::CommandArgs args) {
+    if (!args.empty() && args[0] == "clear") {
+        cache.clear();
+        std::cout << "Result cache cleared" << std::endl;
+        return;
+    }
+
+    if (!args.empty() && args[0] == "budget" && args.size() == 2) {
+        try {
+            cache.set_row_budget(parse_byte_size(std::string(args[1])));
+            std::cout << "Row cache budget set to " << format_bytes(cache.stats().row_budget) << std::endl;
+        } catch (const std::exception&) {
+            std::cout << "Invalid size: " << args[1] << " (examples: 64M, 1G)" << std::endl;
+            console.report_failure();
+        }
+        return;
+    }
+
+    if (!args.empty()) {
+        std::cout << "Usage: cache [clear | budget <size>]" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    const ResultCache::Stats stats = cache.stats();
+    std::cout << "=== RESULT CACHE ===" << std::endl;
+    std::cout << "Distance rows: " << stats.rows << " (" << format_bytes(stats.row_bytes) << " of "
+              << format_bytes(stats.row_budget) << "), hits " << stats.row_hits << ", misses " << stats.row_misses << std::endl;
+    std::cout << "Analyses: " << stats.analyses << ", hits " << stats.analysis_hits
+              << ", misses " << stats.analysis_misses << std::endl;
+}
+
+bool GraphConsoleAdapter::strip_background_flag(Console::CommandArgs &args) {
+    if (args.empty() || args.back() != "&") return false;
+    args = args.first(args.size() - 1);
+    return true;
+}
+
+void GraphConsoleAdapter::run_job(const std::string &description, JobManager::Task task, const bool background) {
+    const int id = jobs.submit(description, std::move(task));
+    if (background) {
+        std::cout << "[" << id << "] " << description << " started in background" << std::endl;
+        return;
+    }
+    if (!wait_job(id)) console.report_failure();
+}
+
+bool GraphConsoleAdapter::wait_job(const int id) {
+    const bool show_progress = !console.is_batch_mode();
+    bool progress_shown = false;
+
+    JobStatus status;
+    const bool found = jobs.wait(id, [&](const JobStatus& progress) {
+        if (!show_progress || progress.state != JobState::Running || progress.total == 0) return;
+        std::cout << "\r[" << progress.id << "] " << progress.description << ": "
+                  << progress.done * 100 / progress.total << "% (" << progress.done << "/" << progress.total
+                  << "), " << format_fixed(progress.seconds, 1) << "s   " << std::flush;
+        progress_shown = true;
+    }, status);
+
+    if (progress_shown) std::cout << "\r" << std::string(60, ' ') << "\r";
+
+    if (!found) {
+        std::cout << "No such job: " << id << std::endl;
+        return false;
+    }
+
+    std::cout << status.output;
+    switch (status.state) {
+        case JobState::Cancelled:
+            std::cout << "[" << id << "] " << status.description << " cancelled" << std::endl;
+            return false;
+        case JobState::Failed:
+            std::cout << "[" << id << "] " << status.description << " failed: " << status.error << std::endl;
+            return false;
+        default:
+            return true;
+    }
+}
+
+void GraphConsoleAdapter::cmd_jobs() const {
+    const auto list = jobs.list();
+    if (list.empty()) {
+        std::cout << "No jobs" << std::endl;
+        return;
+    }
+
+    std::cout << std::left << std::setw(5) << "ID" << std::setw(11) << "STATE" << std::setw(10) << "PROGRESS"
+              << std::setw(10) << "TIME" << "COMMAND" << std::endl;
+    for (const JobStatus& job : list) {
+        std::string progress = "-";
+        if (job.total != 0) progress = std::to_string(job.done * 100 / job.total) + "%";
+
+        const std::string time = format_fixed(job.seconds, 1) + "s";
+
+        std::cout << std::setw(5) << job.id << std::setw(11) << JobManager::state_name(job.state)
+                  << std::setw(10) << progress << std::setw(10) << time << job.description << std::endl;
+    }
+    std::cout << std::right;
+}
+
+void GraphConsoleAdapter::cmd_wait(Console::CommandArgs args) {
+    try {
+        if (args.empty()) throw std::invalid_argument("missing job id");
+        if (!wait_job(Console::parse_int(args[0]))) console.report_failure();
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        std::cout << "Usage: wait <id>" << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_cancel(Console::CommandArgs args) {
+    try {
+        if (args.empty()) throw std::invalid_argument("missing job id");
+        const int id = Console::parse_int(args[0]);
+        if (jobs.cancel(id)) {
+            std::cout << "Cancellation requested for job " << id << std::endl;
+        } else {
+            std::cout << "No running or queued job with id " << id << std::endl;
+            console.report_failure();
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        std::cout << "Usage: cancel <id>" << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_mem(Console::CommandArgs args) {
+    if (!args.empty()) {
+        if (args[0] != "budget" || args.size() < 2) {
+            std::cout << "Usage: mem [budget <size|auto>]" << std::endl;
+            console.report_failure();
+            return;
+        }
+
+        try {
+            set_memory_budget(args[1] == "auto" ? 0 : parse_byte_size(std::string(args[1])));
+            std::cout << "Memory budget set to " << format_bytes(get_memory_budget()) << std::endl;
+        } catch (const std::exception&) {
+            std::cout << "Invalid size: " << args[1] << " (examples: 512M, 4G, auto)" << std::endl;
+            console.report_failure();
+        }
+        return;
+    }
+
+    constexpr int name_width = 18;
+    constexpr int value_width = 12;
+
+    std::cout << "=== MEMORY ===" << std::endl;
+    std::cout << std::left << std::setw(name_width) << "Structure" << std::right
+              << std::setw(value_width) << "Current" << std::setw(value_width) << "Peak" << std::endl;
+
+    for (int i = 0; i < static_cast<int>(MemoryCategory::Count); i++) {
+        const auto category = static_cast<MemoryCategory>(i);
+        const MemoryUsage usage = get_memory_usage(category);
+        std::cout << std::left << std::setw(name_width) << memory_category_name(category) << std::right
+                  << std::setw(value_width) << format_bytes(usage.current)
+                  << std::setw(value_width) << format_bytes(usage.peak) << std::endl;
+    }
+
+    const MemoryUsage total = get_total_memory_usage();
+    const MemoryUsage rss = get_process_rss();
+    std::cout << std::left << std::setw(name_width) << "Total tracked" << std::right
+              << std::setw(value_width) << format_bytes(total.current)
+              << std::setw(value_width) << format_bytes(total.peak) << std::endl;
+    std::cout << std::left << std::setw(name_width) << "Process RSS" << std::right
+              << std::setw(value_width) << format_bytes(rss.current)
+              << std::setw(value_width) << format_bytes(rss.peak) << std::endl;
+    std::cout << "Memory budget: " << format_bytes(get_memory_budget()) << std::endl;
+}
+
+void GraphConsoleAdapter::cmd_perf(Console::CommandArgs args) {
+    if (args.empty()) {
+        std::cout << "=== PERFORMANCE ===" << std::endl;
+        std::cout << "Threads: ";
+        if (analysis_options.threads == 0) std::cout << "auto (" << std::max(1u, std::thread::hardware_concurrency()) << ")";
+        else std::cout << analysis_options.threads;
+        std::cout << std::endl;
+        std::cout << "Distance engine: " << distance_engine_name(analysis_options.engine);
+        if (const auto graph = workspace.current_graph()) {
+            const DistanceEngine selected = dispatch_policies([&graph, this](auto weight, auto) {
+                return select_distance_engine<decltype(weight)>(*graph, analysis_options.engine);
+            });
+            std::cout << " (" << distance_engine_name(selected) << " for '" << workspace.current_name() << "')";
+        }
+        std::cout << std::endl;
+        std::cout << "Dense matrix limit: " << dense_matrix_limit << " vertices" << std::endl;
+        return;
+    }
+
+    if (args.size() == 2 && args[0] == "threads") {
+        try {
+            const int threads = Console::parse_int(args[1]);
+            if (threads < 0) throw std::invalid_argument("negative thread count");
+            analysis_options.threads = static_cast<unsigned int>(threads);
+            std::cout << "Threads set to " << (threads == 0 ? "auto" : std::to_string(threads)) << std::endl;
+        } catch (const std::exception&) {
+            std::cout << "Invalid thread count: " << args[1] << " (0 = all cores)" << std::endl;
+            console.report_failure();
+        }
+        return;
+    }
+
+    if (args.size() == 2 && args[0] == "engine") {
+        DistanceEngine engine;
+        if (!parse_distance_engine(args[1], engine)) {
+            std::cout << "Unknown engine: " << args[1] << " (auto, bfs, msbfs, dijkstra, floyd)" << std::endl;
+            console.report_failure();
+            return;
+        }
+        // Weighted engines differ in what they compute, so cached analyses may no longer match
+        if (engine != analysis_options.engine) cache.clear();
+        analysis_options.engine = engine;
+        std::cout << "Distance engine set to " << distance_engine_name(engine) << std::endl;
+        return;
+    }
+
+    std::cout << "Usage: perf [threads <n> | engine <auto|bfs|msbfs|dijkstra|floyd>]" << std::endl;
+    console.report_failure();
+}
+
+void GraphConsoleAdapter::cmd_serve(Console::CommandArgs args) {
+    if (args.empty()) {
+        if (server == nullptr) {
+            std::cout << "Not serving. Usage: serve <socket> [--wait]" << std::endl;
+            return;
+        }
+        const QueryServer::Stats stats = server->stats();
+        std::cout << "Serving on " << server->path() << ": " << stats.active << " open connections, "
+                  << stats.connections << " accepted, " << stats.requests << " requests answered" << std::endl;
+        return;
+    }
+
+    if (args.size() == 1 && args[0] == "stop") {
+        if (server == nullptr) {
+            std::cout << "Not serving" << std::endl;
+            console.report_failure();
+            return;
+        }
+        const std::size_t requests = server->stats().requests;
+        server.reset();
+        std::cout << "Stopped serving after " << requests << " requests" << std::endl;
+        return;
+    }
+
+    const bool wait = args.size() == 2 && args[1] == "--wait";
+    if (args.size() > 2 || (args.size() == 2 && !wait)) {
+        std::cout << "Usage: serve [<socket> [--wait] | stop]" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    const auto graph = require_graph();
+    if (graph == nullptr) return;
+    if (server != nullptr) {
+        std::cout << "Already serving on " << server->path() << "; use 'serve stop' first" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    try {
+        const auto [search, point, path, within, analyse] = dispatch_policies([](auto weight, auto) {
+            return std::tuple{&find_distances<decltype(weight)>, &point_distance<decltype(weight)>,
+                              &point_path<decltype(weight)>, &bounded_search<decltype(weight)>,
+                              &analyse_graph<decltype(weight)>};
+        });
+        auto session = std::make_shared<QuerySession>(graph, workspace.version(workspace.current_name()), weighted,
+                                                      directed, incoming_adjacency(*graph), search, point, path,
+                                                      within, analyse, analysis_options, cache);
+        server = std::make_unique<QueryServer>(std::string(args[0]), [session](const std::string_view request) {
+            return session->answer(request);
+        }, analysis_options.threads);
+    } catch (const std::exception& e) {
+        std::cout << "Error starting server: " << e.what() << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    std::cout << "Serving graph '" << workspace.current_name() << "' on " << server->path()
+              << " (later changes to the graph are not visible to clients)" << std::endl;
+    if (!wait) return;
+
+    // Block until Ctrl-C, which cancels the waiting job
+    JobManager::install_interrupt_handler();
+    std::cout << "Press Ctrl-C to stop" << std::endl;
+    run_job("serve " + server->path(), [](std::ostream&, const CancelToken& token) {
+        while (!token.is_cancelled()) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }, false);
+    const std::size_t requests = server->stats().requests;
+    server.reset();
+    std::cout << "Stopped serving after " << requests << " requests" << std::endl;
+}
+
+void GraphConsoleAdapter::cmd_query(Console::CommandArgs args) {
+    if (args.size() < 2) {
+        std::cout << "Usage: query <socket> <request...>" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    std::string request(args[1]);
+    for (const auto& arg : args.subspan(2)) request += " " + std::string(arg);
+
+    try {
+        QueryClient client{std::string(args[0])};
+        const std::string response = client.request(request);
+        std::cout << response << std::endl;
+        if (response.starts_with("ERR")) console.report_failure();
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        console.report_failure();
+    }
+}
+
+void GraphConsoleAdapter::cmd_reorder(Console::CommandArgs args) {
+    auto graph = require_graph();
+    if (graph == nullptr) return;
+
+    VertexOrder order;
+    if (args.size() != 1 || !parse_vertex_order(args[0], order)) {
+        std::cout << "Usage: reorder <rcm|degree|bfs>" << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    // A snapshot shared with a clone or a job is copied before it is renumbered
+    if (const std::size_t bytes = graph_matrix_bytes(*graph) + graph_list_bytes(*graph);
+        graph.use_count() > 2 && !memory_budget_allows(bytes)) {
+        std::cout << "Refusing to reorder: copying the shared graph needs " << format_bytes(bytes)
+                  << ", memory budget is " << format_bytes(get_memory_budget()) << std::endl;
+        console.report_failure();
+        return;
+    }
+
+    const int before = graph_bandwidth(*graph);
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<int> permutation = compute_vertex_order(*graph, order);
+
+    const std::string name = workspace.current_name();
+    graph.reset(); // otherwise modify sees a second owner and copies
+    workspace.modify(name, [&permutation](Graph& g) { apply_vertex_order(g, permutation); });
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    prune_cache();
+
+    std::cout << "Reordered graph '" << name << "' by " << args[0] << " in " << format_fixed(elapsed.count(), 1)
+              << " ms (bandwidth " << before << " -> " << graph_bandwidth(*workspace.get(name)) << ")" << std::endl;
 }
@@ -0,0 +1,219 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/centrality.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "../../include/backend/graph_gen.h"
+#include "../../include/backend/graph_policies.h"
+#include "../../include/backend/task_pool.h"
+
+namespace {
+    /**
+     * Per-thread state: labels of the current search, reset through the
+     * order list, and the thread's share of the centrality sums.
+     */
+    struct CentralityWorkspace {
+        std::vector<int> dist;
+        std::vector<double> sigma;              ///< Number of shortest paths from the source
+        std::vector<double> delta;              ///< Dependency of the source on every vertex
+        std::vector<int> order;                 ///< Settled vertices in order of non-decreasing distance
+        std::vector<std::pair<int, int>> heap;  ///< (distance, vertex) min-heap of Dijkstra
+        std::vector<double> sum;                ///< Accumulated centrality (or distance sums for closeness)
+        std::vector<double> reached;            ///< Closeness only: sources that reach every vertex
+
+        void prepare(const int n) {
+            if (!dist.empty()) return;
+            dist.assign(n, -1);
+            sigma.assign(n, 0.0);
+            delta.assign(n, 0.0);
+            sum.assign(n, 0.0);
+            reached.assign(n, 0.0);
+        }
+    };
+
+    /**
+     * Single-source shortest paths from source, counting shortest paths.
+     * Fills ws.order with every reached vertex in order of non-decreasing distance.
+     */
+    template <typename Weight, typename Adjacency>
+    void count_paths(const Adjacency &adj, const int source, CentralityWorkspace &ws) {
+        ws.order.clear();
+        ws.dist[source] = 0;
+        ws.sigma[source] = 1.0;
+
+        if constexpr (Weight::value && Adjacency::has_weights) {
+            ws.heap.clear();
+            ws.heap.emplace_back(0, source);
+            while (!ws.heap.empty()) {
+                std::ranges::pop_heap(ws.heap, std::greater<>{});
+                const auto [d, v] = ws.heap.back();
+                ws.heap.pop_back();
+                if (d > ws.dist[v]) continue; // stale entry
+                ws.order.push_back(v);
+
+                adj.for_each_neighbour(v, [&](const int w, const int weight) {
+                    const int candidate = d + weight;
+                    if (ws.dist[w] == -1 || candidate < ws.dist[w]) {
+                        ws.dist[w] = candidate;
+                        ws.sigma[w] = ws.sigma[v];
+                        ws.heap.emplace_back(candidate, w);
+                        std::ranges::push_heap(ws.heap, std::greater<>{});
+                    } else if (candidate == ws.dist[w]) {
+                        ws.sigma[w] += ws.sigma[v];
+                    }
+                });
+            }
+        } else {
+            // order doubles as the BFS queue
+            ws.order.push_back(source);
+            for (std::size_t head = 0; head < ws.order.size(); head++) {
+                const int v = ws.order[head];
+                adj.for_each_neighbour(v, [&](const int w, int) {
+                    if (ws.dist[w] == -1) {
+                        ws.dist[w] = ws.dist[v] + 1;
+                        ws.sigma[w] = ws.sigma[v];
+                        ws.order.push_back(w);
+                    } else if (ws.dist[w] == ws.dist[v] + 1) {
+                        ws.sigma[w] += ws.sigma[v];
+                    }
+                });
+            }
+        }
+    }
+
+    /**
+     * Brandes' dependency accumulation over successors: a vertex's
+     * dependency is final once all vertices farther from the source are done.
+     */
+    template <typename Weight, typename Adjacency>
+    void accumulate_dependencies(const Adjacency &adj, const int source, CentralityWorkspace &ws) {
+        for (auto it = ws.order.rbegin(); it != ws.order.rend(); ++it) {
+            const int v = *it;
+            double dependency = 0.0;
+            adj.for_each_neighbour(v, [&](const int w, const int weight) {
+                if (ws.dist[w] == ws.dist[v] + (Weight::value ? weight : 1)) {
+                    dependency += ws.sigma[v] / ws.sigma[w] * (1.0 + ws.delta[w]);
+                }
+            });
+            ws.delta[v] = dependency;
+            if (v != source) ws.sum[v] += dependency;
+        }
+    }
+
+    std::vector<int> choose_sources(const int n, const CentralityOptions &options) {
+        std::vector<int> all(n);
+        std::iota(all.begin(), all.end(), 0);
+        if (options.samples <= 0 || options.samples >= n) return all;
+
+        const unsigned int seed = options.seed != 0
+            ? options.seed
+            : static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
+        std::mt19937 gen(seed);
+        std::vector<int> sample;
+        sample.reserve(options.samples);
+        std::ranges::sample(all, std::back_inserter(sample), options.samples, gen);
+        return sample;
+    }
+}
+
+bool parse_centrality_measure(const std::string_view name, CentralityMeasure &measure) {
+    if (name == "closeness") measure = CentralityMeasure::Closeness;
+    else if (name == "harmonic") measure = CentralityMeasure::Harmonic;
+    else if (name == "betweenness") measure = CentralityMeasure::Betweenness;
+    else return false;
+    return true;
+}
+
+const char* centrality_measure_name(const CentralityMeasure measure) {
+    switch (measure) {
+        case CentralityMeasure::Closeness: return "closeness";
+        case CentralityMeasure::Harmonic: return "harmonic";
+        case CentralityMeasure::Betweenness: return "betweenness";
+    }
+    return "unknown";
+}
+
+template <typename Weight, typename Direction>
+std::vector<double> compute_centrality(const Graph &graph, const CentralityMeasure measure,
+                                       const CentralityOptions &options, CancelToken *token) {
+    const int n = graph.n;
+    const std::vector<int> sources = choose_sources(n, options);
+    if (token != nullptr) token->set_total(sources.size());
+
+    std::vector<double> sum(n, 0.0);
+    std::vector<double> reached(n, 0.0);
+
+    std::visit([&](const auto& adj) {
+        for_each_task<CentralityWorkspace>(sources.size(), options.threads,
+            [&](CentralityWorkspace& ws, const std::size_t task) {
+                check_cancelled(token);
+                ws.prepare(n);
+                const int source = sources[task];
+                count_paths<Weight>(adj, source, ws);
+
+                if (measure == CentralityMeasure::Betweenness) {
+                    accumulate_dependencies<Weight>(adj, source, ws);
+                } else {
+                    for (const int v : ws.order) {
+                        if (v == source) continue;
+                        if (measure == CentralityMeasure::Harmonic) {
+                            ws.sum[v] += 1.0 / ws.dist[v];
+                        } else {
+                            ws.sum[v] += ws.dist[v];
+                            ws.reached[v] += 1.0;
+                        }
+                    }
+                }
+
+                for (const int v : ws.order) {
+                    ws.dist[v] = -1;
+                    ws.sigma[v] = 0.0;
+                    ws.delta[v] = 0.0;
+                }
+                if (token != nullptr) token->advance();
+            },
+            [&](const CentralityWorkspace& ws) {
+                if (ws.dist.empty()) return;
+                for (int v = 0; v < n; v++) {
+                    sum[v] += ws.sum[v];
+                    reached[v] += ws.reached[v];
+                }
+            });
+    }, graph.adj_list);
+
+    // A sample of k sources sees k/n of every sum
+    const double scale = sources.empty() ? 0.0 : static_cast<double>(n) / static_cast<double>(sources.size());
+
+    std::vector<double> centrality(n, 0.0);
+    for (int v = 0; v < n; v++) {
+        double value;
+        switch (measure) {
+            case CentralityMeasure::Closeness:
+                value = sum[v] == 0.0 || n < 2 ? 0.0 : reached[v] / sum[v] * (reached[v] * scale / (n - 1));
+                break;
+            case CentralityMeasure::Harmonic:
+                value = sum[v] * scale;
+                break;
+            default:
+                value = sum[v] * scale / (Direction::value ? 1.0 : 2.0);
+                break;
+        }
+        centrality[original_vertex(graph, v)] = value;
+    }
+    return centrality;
+}
+
+template std::vector<double> compute_centrality<Unweighted, Undirected>(const Graph &, CentralityMeasure,
+                                                                        const CentralityOptions &, CancelToken *);
+template std::vector<double> compute_centrality<Unweighted, Directed>(const Graph &, CentralityMeasure,
+                                                                      const CentralityOptions &, CancelToken *);
+template std::vector<double> compute_centrality<Weighted, Undirected>(const Graph &, CentralityMeasure,
+                                                                      const CentralityOptions &, CancelToken *);
+template std::vector<double> compute_centrality<Weighted, Directed>(const Graph &, CentralityMeasure,
+                                                                    const CentralityOptions &, CancelToken *);
@@ -0,0 +1,148 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/components.h"
+#include "../../include/backend/graph_gen.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+    int find_root(std::vector<int> &parent, int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]]; // path halving
+            v = parent[v];
+        }
+        return v;
+    }
+
+    /**
+     * Renumbers arbitrary labels into dense ids ordered by smallest vertex
+     * and collects members of every component.
+     */
+    ComponentInfo make_component_info(const std::vector<int> &labels) {
+        const int n = static_cast<int>(labels.size());
+        ComponentInfo info;
+        info.component_of.assign(n, -1);
+
+        std::vector<int> id_of_label(n, -1);
+        for (int v = 0; v < n; v++) {
+            int& id = id_of_label[labels[v]];
+            if (id == -1) {
+                id = info.count++;
+                info.members.emplace_back();
+            }
+            info.component_of[v] = id;
+            info.members[id].push_back(v);
+        }
+        return info;
+    }
+
+    template <typename Adjacency>
+    ComponentInfo strong_components(const Adjacency &adj) {
+        const int n = adj.size();
+        constexpr int unvisited = -1;
+
+        std::vector<int> index(n, unvisited);
+        std::vector<int> low(n, 0);
+        std::vector<char> on_stack(n, 0);
+        std::vector<int> scc_stack;
+        std::vector<int> label(n, -1);
+        int next_index = 0;
+
+        // Explicit DFS stack of (vertex, next edge to follow in the adjacency arrays)
+        std::vector<std::pair<int, std::size_t>> call_stack;
+        const auto& offsets = adj.offsets;
+
+        for (int root = 0; root < n; root++) {
+            if (index[root] != unvisited) continue;
+
+            call_stack.emplace_back(root, offsets[root]);
+            index[root] = low[root] = next_index++;
+            scc_stack.push_back(root);
+            on_stack[root] = 1;
+
+            while (!call_stack.empty()) {
+                auto& [v, edge] = call_stack.back();
+
+                if (edge < offsets[v + 1]) {
+                    const int u = adj.targets[edge++];
+                    if (index[u] == unvisited) {
+                        index[u] = low[u] = next_index++;
+                        scc_stack.push_back(u);
+                        on_stack[u] = 1;
+                        call_stack.emplace_back(u, offsets[u]);
+                    } else if (on_stack[u]) {
+                        low[v] = std::min(low[v], index[u]);
+                    }
+                    continue;
+                }
+
+                const int finished = v;
+                call_stack.pop_back();
+                if (!call_stack.empty()) {
+                    const int caller = call_stack.back().first;
+                    low[caller] = std::min(low[caller], low[finished]);
+                }
+
+                if (low[finished] == index[finished]) {
+                    int w;
+                    do {
+                        w = scc_stack.back();
+                        scc_stack.pop_back();
+                        on_stack[w] = 0;
+                        label[w] = finished;
+                    } while (w != finished);
+                }
+            }
+        }
+
+        return make_component_info(label);
+    }
+}
+
+ComponentInfo find_connected_components(const Graph &graph) {
+    std::vector<int> parent(graph.n);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    std::visit([&parent](const auto& adj) {
+        for (int v = 0; v < adj.size(); v++) {
+            for (const int u : adj.neighbours(v)) {
+                const int root_v = find_root(parent, v);
+                const int root_u = find_root(parent, u);
+                if (root_v != root_u) parent[std::max(root_v, root_u)] = std::min(root_v, root_u);
+            }
+        }
+    }, graph.adj_list);
+
+    for (int v = 0; v < graph.n; v++) parent[v] = find_root(parent, v);
+    return make_component_info(parent);
+}
+
+ComponentInfo find_strong_components(const Graph &graph) {
+    return std::visit([](const auto& adj) { return strong_components(adj); }, graph.adj_list);
+}
+
+ComponentInfo relabel_components(const ComponentInfo &components, const std::vector<int> &new_id) {
+    std::vector<int> labels(components.component_of.size());
+    for (int v = 0; v < static_cast<int>(labels.size()); v++) labels[new_id[v]] = components.component_of[v];
+    return make_component_info(labels);
+}
+
+std::vector<ComponentSummary> summarize_components(const ComponentInfo &components, const std::vector<int> &ecc) {
+    std::vector<ComponentSummary> summary;
+    summary.reserve(components.count);
+
+    for (const auto& members : components.members) {
+        int radius = std::numeric_limits<int>::max();
+        int diameter = -1;
+        for (const int v : members) {
+            if (ecc[v] == -1) continue;
+            radius = std::min(radius, ecc[v]);
+            diameter = std::max(diameter, ecc[v]);
+        }
+        summary.push_back({static_cast<int>(members.size()),
+                           radius == std::numeric_limits<int>::max() ? -1 : radius, diameter});
+    }
+    return summary;
+}
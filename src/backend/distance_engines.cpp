@@ -0,0 +1,390 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/distance_engines.h"
+#include "../../include/backend/graph_gen.h"
+#include "../../include/backend/memory_tracker.h"
+#include "../../include/backend/reachability.h"
+#include "../../include/backend/task_pool.h"
+
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <thread>
+
+namespace {
+    /**
+     * Vertex ordering shared by all engines: sources grouped by component, and
+     * the position of every vertex inside its component's member list.
+     */
+    struct ComponentLayout {
+        std::vector<int> local_index;
+        std::vector<int> sources;
+        const ComponentInfo &components;
+        const ReachabilityIndex *reachability;
+
+        ComponentLayout(const ComponentInfo &info, const ReachabilityIndex *index)
+            : local_index(info.component_of.size()), components(info), reachability(index) {
+            sources.reserve(info.component_of.size());
+            for (const auto& members : info.members) {
+                for (int i = 0; i < static_cast<int>(members.size()); i++) local_index[members[i]] = i;
+                sources.insert(sources.end(), members.begin(), members.end());
+            }
+        }
+
+        /**
+         * Number of vertices a search from source labels: exact with a
+         * reachability index, otherwise the size of its component, which is
+         * exact for undirected graphs and an upper bound for directed ones.
+         * A search can stop as soon as it has labelled that many vertices
+         * instead of expanding the last level only to find nothing new.
+         */
+        [[nodiscard]] std::size_t reachable(const int source) const {
+            if (reachability != nullptr) return reachability->reachable_count(source);
+            return components.members[components.component_of[source]].size();
+        }
+    };
+
+    struct QueueWorkspace {
+        std::vector<int> local_dist;
+        std::vector<int> queue;
+        std::vector<int> row; ///< Full row handed to the sink; only component entries are ever set
+    };
+
+    /**
+     * Passes the finished row of source to the sink, then clears the entries
+     * that were set so both buffers are all -1 again. Only the reached
+     * vertices are written and reset, so a source that reaches little of its
+     * component costs little.
+     */
+    void emit_row(const DistanceRowSink &sink, const int source, std::vector<int> &row, const std::vector<int> &reached,
+                  std::vector<int> &local_dist, const std::vector<int> &local_index) {
+        for (const int v : reached) row[v] = local_dist[local_index[v]];
+        sink(source, row);
+        for (const int v : reached) {
+            row[v] = -1;
+            local_dist[local_index[v]] = -1;
+        }
+    }
+
+    template <typename Weight, typename Adjacency>
+    void bfs_rows(const Adjacency &adj, const ComponentInfo &components, const ComponentLayout &layout,
+                  const DistanceRowSink &sink, const unsigned int threads, CancelToken *token) {
+        const int n = adj.size();
+        for_each_task<QueueWorkspace>(layout.sources.size(), threads, [&](QueueWorkspace& ws, const std::size_t task) {
+            const int source = layout.sources[task];
+            const auto& local_index = layout.local_index;
+            const int size = static_cast<int>(components.members[components.component_of[source]].size());
+
+            check_cancelled(token);
+            if (ws.row.empty()) ws.row.assign(n, -1);
+            if (static_cast<int>(ws.local_dist.size()) < size) ws.local_dist.resize(size, -1);
+            ws.queue.clear();
+
+            // Same BFS as BFSD, restricted to the component and indexed locally
+            const std::size_t target = layout.reachable(source);
+            ws.queue.push_back(source);
+            ws.local_dist[local_index[source]] = 0;
+            for (std::size_t head = 0; head < ws.queue.size() && ws.queue.size() < target; head++) {
+                const int curr_v = ws.queue[head];
+                const int curr_dist = ws.local_dist[local_index[curr_v]];
+                adj.for_each_neighbour(curr_v, [&](const int next_v, const int weight) {
+                    if (int& dist = ws.local_dist[local_index[next_v]]; dist == -1) {
+                        ws.queue.push_back(next_v);
+                        dist = curr_dist + (Weight::value ? weight : 1);
+                    }
+                });
+            }
+
+            emit_row(sink, source, ws.row, ws.queue, ws.local_dist, local_index); // the queue holds exactly the reached vertices
+            if (token != nullptr) token->advance();
+        });
+    }
+
+    struct HeapWorkspace {
+        std::vector<int> local_dist;
+        std::vector<std::pair<int, int>> heap;
+        std::vector<int> reached; ///< Vertices labelled by the current search
+        std::vector<int> row;
+    };
+
+    template <typename Weight, typename Adjacency>
+    void dijkstra_rows(const Adjacency &adj, const ComponentInfo &components, const ComponentLayout &layout,
+                       const DistanceRowSink &sink, const unsigned int threads, CancelToken *token) {
+        const int n = adj.size();
+        for_each_task<HeapWorkspace>(layout.sources.size(), threads, [&](HeapWorkspace& ws, const std::size_t task) {
+            const int source = layout.sources[task];
+            const auto& local_index = layout.local_index;
+            const int size = static_cast<int>(components.members[components.component_of[source]].size());
+
+            check_cancelled(token);
+            if (ws.row.empty()) ws.row.assign(n, -1);
+            if (static_cast<int>(ws.local_dist.size()) < size) ws.local_dist.resize(size, -1);
+            ws.heap.clear();
+            ws.reached.clear();
+
+            // Min-heap of (distance, vertex); stale entries are skipped when popped
+            constexpr auto later = std::greater<std::pair<int, int>>();
+            const std::size_t target = layout.reachable(source);
+            std::size_t settled = 0;
+            ws.heap.emplace_back(0, source);
+            ws.reached.push_back(source);
+            ws.local_dist[local_index[source]] = 0;
+            while (!ws.heap.empty()) {
+                std::pop_heap(ws.heap.begin(), ws.heap.end(), later);
+                const auto [curr_dist, curr_v] = ws.heap.back();
+                ws.heap.pop_back();
+                if (curr_dist != ws.local_dist[local_index[curr_v]]) continue;
+                if (++settled == target) break; // every reachable vertex is final
+
+                adj.for_each_neighbour(curr_v, [&](const int next_v, const int weight) {
+                    const int candidate = curr_dist + (Weight::value ? weight : 1);
+                    if (int& dist = ws.local_dist[local_index[next_v]]; dist == -1 || candidate < dist) {
+                        if (dist == -1) ws.reached.push_back(next_v);
+                        dist = candidate;
+                        ws.heap.emplace_back(candidate, next_v);
+                        std::push_heap(ws.heap.begin(), ws.heap.end(), later);
+                    }
+                });
+            }
+
+            emit_row(sink, source, ws.row, ws.reached, ws.local_dist, local_index);
+            if (token != nullptr) token->advance();
+        });
+    }
+
+    struct BitWorkspace {
+        std::vector<std::uint64_t> seen;
+        std::vector<std::uint64_t> visit;
+        std::vector<std::uint64_t> visit_next;
+        std::vector<int> rows; ///< One full row per source of the batch, all -1 between batches
+        TrackedBytes tracked;  ///< Accounts rows as distance matrix memory while the worker runs
+    };
+
+    /// Cap on the row buffer of one MS-BFS worker; very large graphs get fewer sources per batch
+    constexpr std::size_t msbfs_buffer_bytes = 64ull * 1024 * 1024;
+
+    /**
+     * Returns the row buffer size of one MS-BFS worker: msbfs_buffer_bytes, or
+     * an equal share of what the memory budget leaves free if that is less.
+     */
+    std::size_t msbfs_worker_bytes(const unsigned int workers) {
+        return std::min(msbfs_buffer_bytes, get_free_memory_budget() / workers);
+    }
+
+    /**
+     * Multi-source BFS (Then et al., "The More the Merrier"): up to 64 BFS
+     * traversals of one component share every adjacency scan, with bit b of a
+     * vertex's masks standing for the b-th source of the batch.
+     */
+    template <typename Adjacency>
+    void msbfs_rows(const Adjacency &adj, const ComponentInfo &components, const ComponentLayout &layout,
+                    const DistanceRowSink &sink, const unsigned int threads, CancelToken *token) {
+        const int n = adj.size();
+        const int batch_size = static_cast<int>(std::clamp<std::size_t>(
+            msbfs_worker_bytes(worker_count(threads, n)) / (static_cast<std::size_t>(n) * sizeof(int)), 1, 64));
+
+        // Batches never span components, so all their sources share one local index space
+        std::vector<std::pair<int, int>> batches; // (component, first member)
+        for (int id = 0; id < components.count; id++) {
+            for (int first = 0; first < static_cast<int>(components.members[id].size()); first += batch_size) {
+                batches.emplace_back(id, first);
+            }
+        }
+
+        for_each_task<BitWorkspace>(batches.size(), threads, [&](BitWorkspace& ws, const std::size_t task) {
+            const auto [component, first] = batches[task];
+            const auto& members = components.members[component];
+            const auto& local_index = layout.local_index;
+            const int size = static_cast<int>(members.size());
+            const int count = std::min(batch_size, size - first);
+
+            check_cancelled(token);
+            if (ws.rows.empty()) {
+                ws.rows.assign(static_cast<std::size_t>(batch_size) * n, -1);
+                ws.tracked = TrackedBytes(MemoryCategory::DistanceMatrix, ws.rows.size() * sizeof(int));
+            }
+            ws.seen.assign(size, 0);
+            ws.visit.assign(size, 0);
+            ws.visit_next.assign(size, 0);
+
+            const auto row_of = [&ws, n](const int b) { return ws.rows.data() + static_cast<std::size_t>(b) * n; };
+
+            std::size_t target = 0;
+            std::size_t labelled = count;
+            for (int b = 0; b < count; b++) {
+                const int source = members[first + b];
+                target += layout.reachable(source);
+                ws.seen[local_index[source]] |= std::uint64_t{1} << b;
+                ws.visit[local_index[source]] |= std::uint64_t{1} << b;
+                row_of(b)[source] = 0;
+            }
+
+            for (int level = 1; labelled < target; level++) {
+                for (int i = 0; i < size; i++) {
+                    if (ws.visit[i] == 0) continue;
+                    for (const int next_v : adj.neighbours(members[i])) ws.visit_next[local_index[next_v]] |= ws.visit[i];
+                }
+
+                bool frontier = false;
+                for (int i = 0; i < size; i++) {
+                    std::uint64_t reached = ws.visit_next[i] & ~ws.seen[i];
+                    ws.visit_next[i] = 0;
+                    ws.visit[i] = reached;
+                    if (reached == 0) continue;
+
+                    frontier = true;
+                    labelled += std::popcount(reached);
+                    ws.seen[i] |= reached;
+                    for (; reached != 0; reached &= reached - 1) row_of(std::countr_zero(reached))[members[i]] = level;
+                }
+                if (!frontier) break;
+                check_cancelled(token);
+            }
+
+            for (int b = 0; b < count; b++) {
+                int* row = row_of(b);
+                sink(members[first + b], std::span<const int>(row, n));
+                for (const int v : members) row[v] = -1;
+            }
+            if (token != nullptr) token->advance(count);
+        });
+    }
+
+    template <typename Weight>
+    void floyd_rows(const Graph &graph, std::vector<std::vector<int>> &distances, unsigned int threads,
+                    CancelToken *token) {
+        const int n = graph.n;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                const int weight = graph.adj_matrix[i][j];
+                distances[i][j] = i == j ? 0 : weight == 0 ? -1 : Weight::value ? weight : 1;
+            }
+        }
+
+        // Rows are split between threads; one barrier phase per intermediate vertex k.
+        // The completion step samples cancellation once, so every thread sees the same decision.
+        const unsigned int workers = worker_count(threads, n);
+        bool stop = false;
+        std::barrier sync(workers, [&stop, token]() noexcept {
+            if (token != nullptr) {
+                token->advance();
+                stop = token->is_cancelled();
+            }
+        });
+
+        auto worker = [&](const unsigned int t) {
+            for (int k = 0; k < n && !stop; k++) {
+                const auto& via = distances[k];
+                for (int i = static_cast<int>(t); i < n; i += static_cast<int>(workers)) {
+                    auto& row = distances[i];
+                    const int to_k = row[k];
+                    if (to_k == -1 || i == k) continue;
+                    for (int j = 0; j < n; j++) {
+                        if (via[j] != -1 && (row[j] == -1 || to_k + via[j] < row[j])) row[j] = to_k + via[j];
+                    }
+                }
+                sync.arrive_and_wait();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned int t = 1; t < workers; t++) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& thread : pool) thread.join();
+
+        check_cancelled(token);
+    }
+}
+
+bool parse_distance_engine(const std::string_view name, DistanceEngine &engine) {
+    if (name == "auto") engine = DistanceEngine::Auto;
+    else if (name == "bfs") engine = DistanceEngine::Bfs;
+    else if (name == "msbfs") engine = DistanceEngine::MsBfs;
+    else if (name == "dijkstra") engine = DistanceEngine::Dijkstra;
+    else if (name == "floyd") engine = DistanceEngine::Floyd;
+    else return false;
+    return true;
+}
+
+const char* distance_engine_name(const DistanceEngine engine) {
+    switch (engine) {
+        case DistanceEngine::Auto: return "auto";
+        case DistanceEngine::Bfs: return "bfs";
+        case DistanceEngine::MsBfs: return "msbfs";
+        case DistanceEngine::Dijkstra: return "dijkstra";
+        case DistanceEngine::Floyd: return "floyd";
+    }
+    return "unknown";
+}
+
+template <typename Weight>
+DistanceEngine select_distance_engine(const Graph &graph, const DistanceEngine requested) {
+    switch (requested) {
+        case DistanceEngine::Auto:
+            return !Weight::value && graph.n >= 64 ? DistanceEngine::MsBfs : DistanceEngine::Bfs;
+        case DistanceEngine::MsBfs:
+            return Weight::value ? DistanceEngine::Bfs : DistanceEngine::MsBfs;
+        case DistanceEngine::Floyd:
+            return graph.adj_matrix != nullptr ? DistanceEngine::Floyd : DistanceEngine::Dijkstra;
+        default:
+            return requested;
+    }
+}
+
+template <typename Weight>
+void compute_distance_rows(const Graph &graph, const ComponentInfo &components, const AnalysisOptions &options,
+                           const DistanceRowSink &sink, CancelToken *token) {
+    if (token != nullptr) token->set_total(graph.n);
+
+    DistanceEngine engine = select_distance_engine<Weight>(graph, options.engine);
+    if (engine == DistanceEngine::Floyd) engine = DistanceEngine::Dijkstra;
+
+    const ComponentLayout layout(components, options.reachability);
+    std::visit([&](const auto& adj) {
+        switch (engine) {
+            case DistanceEngine::MsBfs:
+                msbfs_rows(adj, components, layout, sink, options.threads, token);
+                break;
+            case DistanceEngine::Dijkstra:
+                dijkstra_rows<Weight>(adj, components, layout, sink, options.threads, token);
+                break;
+            default:
+                bfs_rows<Weight>(adj, components, layout, sink, options.threads, token);
+                break;
+        }
+    }, graph.adj_list);
+}
+
+template <typename Weight>
+std::vector<std::vector<int>> compute_distance_matrix(const Graph &graph, const ComponentInfo &components,
+                                                      const AnalysisOptions &options, CancelToken *token) {
+    if (select_distance_engine<Weight>(graph, options.engine) == DistanceEngine::Floyd) {
+        std::vector<std::vector<int>> distances(graph.n, std::vector<int>(graph.n, -1));
+        if (token != nullptr) token->set_total(graph.n);
+        floyd_rows<Weight>(graph, distances, options.threads, token);
+        return distances;
+    }
+
+    // Every vertex is the source of exactly one row, so rows are allocated by the worker that fills them
+    std::vector<std::vector<int>> distances(graph.n);
+    compute_distance_rows<Weight>(graph, components, options, [&distances](const int source, const std::span<const int> row) {
+        distances[source].assign(row.begin(), row.end());
+    }, token);
+    return distances;
+}
+
+template DistanceEngine select_distance_engine<Unweighted>(const Graph &, DistanceEngine);
+template DistanceEngine select_distance_engine<Weighted>(const Graph &, DistanceEngine);
+
+template void compute_distance_rows<Unweighted>(const Graph &, const ComponentInfo &, const AnalysisOptions &,
+                                                const DistanceRowSink &, CancelToken *);
+template void compute_distance_rows<Weighted>(const Graph &, const ComponentInfo &, const AnalysisOptions &,
+                                              const DistanceRowSink &, CancelToken *);
+
+template std::vector<std::vector<int>> compute_distance_matrix<Unweighted>(const Graph &, const ComponentInfo &,
+                                                                           const AnalysisOptions &, CancelToken *);
+template std::vector<std::vector<int>> compute_distance_matrix<Weighted>(const Graph &, const ComponentInfo &,
+                                                                         const AnalysisOptions &, CancelToken *);
@@ -0,0 +1,239 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/distance_file.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char magic[4] = {'G', 'D', 'M', '1'};
+
+    struct FileHeader {
+        char magic[4];
+        std::uint32_t reserved;
+        std::int64_t n;
+    };
+    static_assert(sizeof(FileHeader) == 16);
+    static_assert(sizeof(int) == 4, "matrix files store 32-bit distances");
+
+    /// A name next to path no other writer uses, in this process or another
+    std::string temporary_name(const std::string& path) {
+        static std::atomic<unsigned long long> counter{0};
+#ifdef _WIN32
+        const unsigned long process = GetCurrentProcessId();
+#else
+        const long process = getpid();
+#endif
+        return path + ".tmp-" + std::to_string(process) + "-" + std::to_string(counter++);
+    }
+
+    std::runtime_error file_error(const std::string& action, const std::string& path) {
+#ifdef _WIN32
+        return std::runtime_error("cannot " + action + " '" + path + "' (error " + std::to_string(GetLastError()) + ")");
+#else
+        return std::runtime_error("cannot " + action + " '" + path + "': " + std::strerror(errno));
+#endif
+    }
+}
+
+std::size_t DistanceMatrixFile::file_bytes(const int n) {
+    const auto count = static_cast<std::size_t>(n);
+    return sizeof(FileHeader) + count * count * sizeof(int);
+}
+
+std::shared_ptr<DistanceMatrixFile> DistanceMatrixFile::create(const std::string &path, const int n, const bool keep) {
+    if (n <= 0) throw std::invalid_argument("distance matrix file needs at least one vertex");
+
+    std::shared_ptr<DistanceMatrixFile> file(new DistanceMatrixFile());
+    file->file_path = temporary_name(path);
+    file->target_path = path;
+    file->n = n;
+    file->writable = true;
+    file->keep_file = keep;
+    const std::string& created = file->file_path;
+
+#ifdef _WIN32
+    file->file_handle = CreateFileA(created.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                    nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file->file_handle == INVALID_HANDLE_VALUE) {
+        file->file_handle = nullptr;
+        throw file_error("create", created);
+    }
+#else
+    file->file_descriptor = ::open(created.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (file->file_descriptor == -1) throw file_error("create", created);
+    if (ftruncate(file->file_descriptor, static_cast<off_t>(file_bytes(n))) != 0) throw file_error("resize", created);
+#endif
+
+    file->map(file_bytes(n));
+    file->rows_offset = sizeof(FileHeader);
+
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.n = n;
+    std::memcpy(file->mapping, &header, sizeof(header));
+    return file;
+}
+
+std::shared_ptr<DistanceMatrixFile> DistanceMatrixFile::open(const std::string &path) {
+    std::shared_ptr<DistanceMatrixFile> file(new DistanceMatrixFile());
+    file->file_path = path;
+
+    const std::size_t bytes = file->open_read_only();
+    if (bytes < sizeof(FileHeader)) throw std::runtime_error("'" + path + "' is not a distance matrix file");
+    file->map(bytes);
+    file->rows_offset = sizeof(FileHeader);
+
+    FileHeader header{};
+    std::memcpy(&header, file->mapping, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.n <= 0 || header.n > INT32_MAX
+        || file_bytes(static_cast<int>(header.n)) != bytes) {
+        throw std::runtime_error("'" + path + "' is not a distance matrix file");
+    }
+    file->n = static_cast<int>(header.n);
+    return file;
+}
+
+std::shared_ptr<DistanceMatrixFile> DistanceMatrixFile::open_embedded(const std::string &path, const std::size_t offset,
+                                                                      const int n) {
+    if (n <= 0) throw std::invalid_argument("distance matrix file needs at least one vertex");
+
+    std::shared_ptr<DistanceMatrixFile> file(new DistanceMatrixFile());
+    file->file_path = path;
+    file->n = n;
+
+    const std::size_t bytes = file->open_read_only();
+    if (bytes < offset + file_bytes(n) - sizeof(FileHeader)) {
+        throw std::runtime_error("'" + path + "' is too short for a " + std::to_string(n) + "×" + std::to_string(n)
+                                 + " distance matrix");
+    }
+    file->map(bytes);
+    file->rows_offset = offset;
+    return file;
+}
+
+std::size_t DistanceMatrixFile::open_read_only() {
+#ifdef _WIN32
+    file_handle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        throw file_error("open", file_path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_handle, &size)) throw file_error("stat", file_path);
+    return static_cast<std::size_t>(size.QuadPart);
+#else
+    file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor == -1) throw file_error("open", file_path);
+    struct stat info{};
+    if (fstat(file_descriptor, &info) != 0) throw file_error("stat", file_path);
+    return static_cast<std::size_t>(info.st_size);
+#endif
+}
+
+void DistanceMatrixFile::map(const std::size_t bytes) {
+#ifdef _WIN32
+    const auto size = static_cast<unsigned long long>(bytes);
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                        static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+    if (mapping_handle == nullptr) throw file_error("map", file_path);
+    void* view = MapViewOfFile(mapping_handle, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, bytes);
+    if (view == nullptr) throw file_error("map", file_path);
+#else
+    void* view = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file_descriptor, 0);
+    if (view == MAP_FAILED) throw file_error("map", file_path);
+#endif
+    mapping = static_cast<std::byte*>(view);
+    mapping_bytes = bytes;
+}
+
+DistanceMatrixFile::~DistanceMatrixFile() {
+#ifdef _WIN32
+    if (mapping != nullptr) UnmapViewOfFile(mapping);
+    if (mapping_handle != nullptr) CloseHandle(mapping_handle);
+    if (file_handle != nullptr) CloseHandle(file_handle);
+    if (!keep_file || !target_path.empty()) DeleteFileA(file_path.c_str());
+#else
+    if (mapping != nullptr) munmap(mapping, mapping_bytes);
+    if (file_descriptor != -1) close(file_descriptor);
+    if (!keep_file || !target_path.empty()) unlink(file_path.c_str());
+#endif
+}
+
+void DistanceMatrixFile::commit() {
+    if (!keep_file || target_path.empty()) return;
+#ifdef _WIN32
+    if (!MoveFileExA(file_path.c_str(), target_path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        throw file_error("rename to", target_path);
+    }
+#else
+    if (std::rename(file_path.c_str(), target_path.c_str()) != 0) throw file_error("rename to", target_path);
+#endif
+    file_path = std::move(target_path);
+    target_path.clear();
+}
+
+int* DistanceMatrixFile::rows() const {
+    return reinterpret_cast<int*>(mapping + rows_offset);
+}
+
+std::span<const int> DistanceMatrixFile::row(const int v) const {
+    return {rows() + static_cast<std::size_t>(v) * n, static_cast<std::size_t>(n)};
+}
+
+std::span<int> DistanceMatrixFile::mutable_row(const int v) {
+    if (!writable) throw std::logic_error("distance matrix file '" + file_path + "' is read-only");
+    return {rows() + static_cast<std::size_t>(v) * n, static_cast<std::size_t>(n)};
+}
+
+void DistanceMatrixFile::flush_rows(const int first, const int count) {
+    if (!writable || count <= 0) return;
+
+    const auto begin = reinterpret_cast<std::byte*>(rows() + static_cast<std::size_t>(first) * n);
+    const std::size_t length = static_cast<std::size_t>(count) * n * sizeof(int);
+#ifdef _WIN32
+    FlushViewOfFile(begin, length);
+#elif defined(__linux__)
+    // Starts writeback of just this range; msync(MS_ASYNC) is a no-op on Linux
+    sync_file_range(file_descriptor, begin - mapping, static_cast<off_t>(length), SYNC_FILE_RANGE_WRITE);
+#else
+    // msync needs a page-aligned start
+    const std::size_t skew = static_cast<std::size_t>(begin - mapping) % static_cast<std::size_t>(sysconf(_SC_PAGE_SIZE));
+    msync(begin - skew, length + skew, MS_ASYNC);
+#endif
+}
+
+void DistanceMatrixFile::sync() {
+    if (!writable) return;
+#ifdef _WIN32
+    FlushViewOfFile(mapping, mapping_bytes);
+    FlushFileBuffers(file_handle);
+#else
+    msync(mapping, mapping_bytes, MS_SYNC);
+#endif
+}
+
+void DistanceMatrixFile::advise_sequential() const {
+#ifndef _WIN32
+    madvise(mapping, mapping_bytes, MADV_SEQUENTIAL);
+#endif
+}
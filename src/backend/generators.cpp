@@ -0,0 +1,529 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/generators.h"
+#include "../../include/backend/memory_tracker.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    struct GeneratedEdge {
+        int u;
+        int v;
+        int weight;
+    };
+
+    std::uint64_t splitmix64(std::uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * Counter-based random stream: the stream of one edge depends only on the
+     * seed and the edge index, never on which thread draws it.
+     */
+    class EdgeRandom {
+    public:
+        EdgeRandom(const std::uint64_t seed, const std::uint64_t stream) : state(splitmix64(seed ^ splitmix64(stream))) {}
+
+        std::uint64_t next() {
+            state += 0x9E3779B97F4A7C15ull;
+            return splitmix64(state);
+        }
+
+        double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+        std::uint64_t below(const std::uint64_t bound) {
+            return std::min(static_cast<std::uint64_t>(uniform() * static_cast<double>(bound)), bound - 1);
+        }
+
+        int weight() { return static_cast<int>(below(10)) + 1; }
+
+    private:
+        std::uint64_t state;
+    };
+
+    /**
+     * Runs fn(begin, end) over [0, count) split into contiguous blocks, one per thread.
+     */
+    template <typename Fn>
+    void parallel_blocks(const std::size_t count, unsigned int threads, Fn fn) {
+        constexpr std::size_t min_block = 1 << 16;
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned int>(std::clamp<std::size_t>(count / min_block, 1, threads));
+
+        if (threads == 1) {
+            fn(std::size_t{0}, count);
+            return;
+        }
+
+        const std::size_t block = (count + threads - 1) / threads;
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (unsigned int t = 0; t < threads; t++) {
+            const std::size_t begin = std::min(count, t * block);
+            const std::size_t end = std::min(count, begin + block);
+            pool.emplace_back([&fn, begin, end] { fn(begin, end); });
+        }
+        for (auto& thread : pool) thread.join();
+    }
+
+    /**
+     * Draws edge e of the model; the result depends only on the seed and e.
+     */
+    template <typename Weight>
+    GeneratedEdge draw_edge(const ModelSpec &spec, const std::uint64_t seed, const int n, const std::size_t e) {
+        EdgeRandom random(seed, e);
+        GeneratedEdge edge{};
+
+        switch (spec.model) {
+            case GraphModel::Rmat: {
+                // Descend scale levels of the adjacency matrix, picking a quadrant at each level
+                int u = 0;
+                int v = 0;
+                for (int level = 0; level < spec.scale; level++) {
+                    const double r = random.uniform();
+                    const int down = r >= spec.a + spec.b;
+                    const int right = (r >= spec.a && r < spec.a + spec.b) || r >= spec.a + spec.b + spec.c;
+                    u = u << 1 | down;
+                    v = v << 1 | right;
+                }
+                edge.u = u;
+                edge.v = v;
+                break;
+            }
+            case GraphModel::BarabasiAlbert: {
+                // Position 2e holds the new vertex, position 2e + 1 a copy of a uniformly chosen
+                // earlier position; following copies back to an even position resolves the target
+                std::uint64_t position = 2 * static_cast<std::uint64_t>(e) + 1;
+                while (position % 2 == 1) position = EdgeRandom(~seed, position).below(position);
+                edge.u = static_cast<int>(e / spec.attach);
+                edge.v = static_cast<int>(position / 2 / spec.attach);
+                break;
+            }
+            case GraphModel::WattsStrogatz: {
+                const int half = spec.neighbours / 2;
+                edge.u = static_cast<int>(e / half);
+                edge.v = (edge.u + static_cast<int>(e % half) + 1) % n;
+                if (random.uniform() < spec.rewire) edge.v = static_cast<int>(random.below(n));
+                break;
+            }
+            case GraphModel::Grid: {
+                const std::size_t horizontal = static_cast<std::size_t>(spec.rows) * (spec.cols - 1);
+                if (e < horizontal) {
+                    const int row = static_cast<int>(e / (spec.cols - 1));
+                    edge.u = row * spec.cols + static_cast<int>(e % (spec.cols - 1));
+                    edge.v = edge.u + 1;
+                } else {
+                    edge.u = static_cast<int>(e - horizontal);
+                    edge.v = edge.u + spec.cols;
+                }
+                break;
+            }
+        }
+        edge.weight = Weight::value ? random.weight() : 1;
+        return edge;
+    }
+
+    template <typename Weight>
+    void draw_edges(const ModelSpec &spec, const std::uint64_t seed, std::vector<GeneratedEdge> &edges,
+                    const unsigned int threads) {
+        const int n = model_vertex_count(spec);
+
+        parallel_blocks(edges.size(), threads, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t e = begin; e < end; e++) edges[e] = draw_edge<Weight>(spec, seed, n, e);
+        });
+    }
+
+    std::uint64_t resolve_seed(const ModelSpec &spec) {
+        if (spec.seed != 0) return spec.seed;
+        return static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    }
+
+    /**
+     * Builds sorted, duplicate-free CSR rows from an edge list by counting sort.
+     */
+    template <typename Adjacency>
+    void build_rows(Adjacency &adj, const int n, const std::vector<GeneratedEdge> &edges, const bool symmetric) {
+        std::vector<std::size_t> offsets(static_cast<std::size_t>(n) + 1, 0);
+        for (const auto& [u, v, weight] : edges) {
+            if (u == v) continue;
+            offsets[u + 1]++;
+            if (symmetric) offsets[v + 1]++;
+        }
+        for (int v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+
+        std::vector<std::pair<int, int>> entries(offsets[n]);
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& [u, v, weight] : edges) {
+            if (u == v) continue;
+            entries[fill[u]++] = {v, weight};
+            if (symmetric) entries[fill[v]++] = {u, weight};
+        }
+
+        adj.offsets.reserve(static_cast<std::size_t>(n) + 1);
+        adj.targets.reserve(entries.size());
+        if constexpr (Adjacency::has_weights) adj.weights.reserve(entries.size());
+
+        for (int v = 0; v < n; v++) {
+            const auto row_begin = entries.begin() + static_cast<std::ptrdiff_t>(offsets[v]);
+            const auto row_end = entries.begin() + static_cast<std::ptrdiff_t>(offsets[v + 1]);
+            std::sort(row_begin, row_end);
+            for (auto it = row_begin; it != row_end; ++it) {
+                // Sorted by (target, weight): the first of equal targets has the smallest weight
+                if (it != row_begin && it->first == std::prev(it)->first) continue;
+                adj.push(it->first, it->second);
+            }
+            adj.end_row();
+        }
+        adj.targets.shrink_to_fit();
+        adj.weights.shrink_to_fit();
+    }
+
+    /**
+     * Sorts every row of a block by (target, weight) and keeps the first of equal targets.
+     */
+    void collect_block_rows(RowBlock &block, std::vector<std::pair<int, int>> &entries,
+                            const std::vector<std::size_t> &offsets, const bool weighted, const unsigned int threads) {
+        const int rows = static_cast<int>(offsets.size()) - 1;
+        std::vector<std::size_t> kept(static_cast<std::size_t>(rows), 0);
+        parallel_blocks(static_cast<std::size_t>(rows), threads, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t r = begin; r < end; r++) {
+                const auto row_begin = entries.begin() + static_cast<std::ptrdiff_t>(offsets[r]);
+                const auto row_end = entries.begin() + static_cast<std::ptrdiff_t>(offsets[r + 1]);
+                std::sort(row_begin, row_end);
+                kept[r] = static_cast<std::size_t>(std::unique(row_begin, row_end, [](const auto& x, const auto& y) {
+                    return x.first == y.first;
+                }) - row_begin);
+            }
+        });
+
+        block.offsets.assign(1, 0);
+        block.offsets.reserve(static_cast<std::size_t>(rows) + 1);
+        for (int r = 0; r < rows; r++) block.offsets.push_back(block.offsets.back() + kept[r]);
+        block.targets.resize(block.offsets.back());
+        if (weighted) block.weights.resize(block.offsets.back());
+        else block.weights.clear();
+
+        parallel_blocks(static_cast<std::size_t>(rows), threads, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t r = begin; r < end; r++) {
+                for (std::size_t i = 0; i < kept[r]; i++) {
+                    const auto& [target, weight] = entries[offsets[r] + i];
+                    block.targets[block.offsets[r] + i] = target;
+                    if (weighted) block.weights[block.offsets[r] + i] = weight;
+                }
+            }
+        });
+    }
+
+    void append_number(std::string &text, const int value) {
+        char digits[16];
+        text.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    }
+
+    /**
+     * Formats the lines of rows [begin, end) of a block into text.
+     */
+    void format_rows(std::string &text, const RowBlock &block, const int begin, const int end, const bool directed) {
+        text.clear();
+        for (int r = begin; r < end; r++) {
+            const int row = block.first_row + r;
+            for (std::size_t i = block.offsets[r]; i < block.offsets[r + 1]; i++) {
+                if (!directed && block.targets[i] < row) continue;
+                append_number(text, row);
+                text.push_back(' ');
+                append_number(text, block.targets[i]);
+                if (!block.weights.empty()) {
+                    text.push_back(' ');
+                    append_number(text, block.weights[i]);
+                }
+                text.push_back('\n');
+            }
+        }
+    }
+}
+
+bool parse_graph_model(const std::string_view name, GraphModel &model) {
+    if (name == "rmat") model = GraphModel::Rmat;
+    else if (name == "ba") model = GraphModel::BarabasiAlbert;
+    else if (name == "ws") model = GraphModel::WattsStrogatz;
+    else if (name == "grid") model = GraphModel::Grid;
+    else return false;
+    return true;
+}
+
+const char* graph_model_name(const GraphModel model) {
+    switch (model) {
+        case GraphModel::Rmat: return "rmat";
+        case GraphModel::BarabasiAlbert: return "ba";
+        case GraphModel::WattsStrogatz: return "ws";
+        case GraphModel::Grid: return "grid";
+    }
+    return "unknown";
+}
+
+std::string validate_model_spec(const ModelSpec &spec) {
+    switch (spec.model) {
+        case GraphModel::Rmat:
+            if (spec.scale < 1 || spec.scale > 30) return "scale must be between 1 and 30";
+            if (spec.edge_factor < 1) return "edge factor must be positive";
+            if (spec.a < 0 || spec.b < 0 || spec.c < 0 || spec.a + spec.b + spec.c > 1) {
+                return "quadrant probabilities a, b, c must be non-negative with a + b + c <= 1";
+            }
+            break;
+        case GraphModel::BarabasiAlbert:
+            if (spec.n < 2) return "number of vertices must be at least 2";
+            if (spec.attach < 1 || spec.attach >= spec.n) return "edges per vertex must be between 1 and n - 1";
+            break;
+        case GraphModel::WattsStrogatz:
+            if (spec.n < 3) return "number of vertices must be at least 3";
+            if (spec.neighbours < 2 || spec.neighbours % 2 != 0 || spec.neighbours >= spec.n) {
+                return "lattice degree k must be even, at least 2 and less than n";
+            }
+            if (spec.rewire < 0 || spec.rewire > 1) return "rewiring probability must be between 0 and 1";
+            break;
+        case GraphModel::Grid:
+            if (spec.rows < 1 || spec.cols < 1) return "rows and columns must be positive";
+            if (static_cast<long long>(spec.rows) * spec.cols > std::numeric_limits<int>::max()) return "grid is too large";
+            break;
+    }
+    return "";
+}
+
+int model_vertex_count(const ModelSpec &spec) {
+    switch (spec.model) {
+        case GraphModel::Rmat: return 1 << spec.scale;
+        case GraphModel::BarabasiAlbert:
+        case GraphModel::WattsStrogatz: return spec.n;
+        case GraphModel::Grid: return spec.rows * spec.cols;
+    }
+    return 0;
+}
+
+std::size_t model_edge_count(const ModelSpec &spec) {
+    const auto n = static_cast<std::size_t>(model_vertex_count(spec));
+    switch (spec.model) {
+        case GraphModel::Rmat: return n * spec.edge_factor;
+        case GraphModel::BarabasiAlbert: return n * spec.attach;
+        case GraphModel::WattsStrogatz: return n * (spec.neighbours / 2);
+        case GraphModel::Grid: return static_cast<std::size_t>(spec.rows) * (spec.cols - 1)
+                                      + static_cast<std::size_t>(spec.rows - 1) * spec.cols;
+    }
+    return 0;
+}
+
+std::size_t estimate_model_footprint(const ModelSpec &spec, const bool weighted, const int dense_matrix_limit) {
+    const int n = model_vertex_count(spec);
+    const auto count = static_cast<std::size_t>(n);
+    const std::size_t edges = model_edge_count(spec);
+
+    // Edge buffer and counting-sort entries live together with the final rows at the peak
+    const std::size_t buffer = edges * sizeof(GeneratedEdge) + 2 * edges * sizeof(std::pair<int, int>);
+    const std::size_t list = (count + 1) * sizeof(std::size_t) * 2 + 2 * edges * adjacency_entry_bytes(n, weighted);
+    const std::size_t matrix = n <= dense_matrix_limit ? count * count * sizeof(int) + count * sizeof(int*) : 0;
+    return buffer + list + matrix;
+}
+
+template <typename Weight, typename Direction>
+Graph generate_model_graph(const ModelSpec &spec, const int dense_matrix_limit, const unsigned int threads) {
+    if (const std::string problem = validate_model_spec(spec); !problem.empty()) {
+        throw std::invalid_argument(problem);
+    }
+
+    const std::uint64_t seed = resolve_seed(spec);
+    const int n = model_vertex_count(spec);
+    std::vector<GeneratedEdge> edges(model_edge_count(spec));
+    draw_edges<Weight>(spec, seed, edges, threads);
+
+    Graph graph;
+    graph.n = n;
+    graph.adj_matrix = nullptr;
+    graph.adj_list = make_adjacency_storage(n, Weight::value);
+    const bool symmetric = !Direction::value || spec.model == GraphModel::Grid;
+    std::visit([&](auto& adj) { build_rows(adj, n, edges, symmetric); }, graph.adj_list);
+
+    edges.clear();
+    edges.shrink_to_fit();
+
+    if (n <= dense_matrix_limit) {
+        graph.adj_matrix = new int*[n];
+        for (int i = 0; i < n; i++) graph.adj_matrix[i] = new int[n]();
+        std::visit([&graph](const auto& adj) {
+            for (int i = 0; i < adj.size(); i++) {
+                adj.for_each_neighbour(i, [&graph, i](const int j, const int weight) { graph.adj_matrix[i][j] = weight; });
+            }
+        }, graph.adj_list);
+    }
+
+    track_allocation(MemoryCategory::AdjacencyMatrix, graph_matrix_bytes(graph));
+    track_allocation(MemoryCategory::AdjacencyList, graph_list_bytes(graph));
+    return graph;
+}
+
+template Graph generate_model_graph<Unweighted, Undirected>(const ModelSpec &, int, unsigned int);
+template Graph generate_model_graph<Unweighted, Directed>(const ModelSpec &, int, unsigned int);
+template Graph generate_model_graph<Weighted, Undirected>(const ModelSpec &, int, unsigned int);
+template Graph generate_model_graph<Weighted, Directed>(const ModelSpec &, int, unsigned int);
+
+template <typename Weight, typename Direction>
+int stream_model_graph(const ModelSpec &spec, const std::size_t memory_limit, const unsigned int threads,
+                       const std::function<void(const RowBlock&)> &sink, CancelToken *token) {
+    if (const std::string problem = validate_model_spec(spec); !problem.empty()) {
+        throw std::invalid_argument(problem);
+    }
+
+    const std::uint64_t seed = resolve_seed(spec);
+    const int n = model_vertex_count(spec);
+    const std::size_t m = model_edge_count(spec);
+    const bool symmetric = !Direction::value || spec.model == GraphModel::Grid;
+
+    // At the peak of a block its kept edges and counting-sort entries live together
+    constexpr std::size_t entry_bytes = sizeof(GeneratedEdge) + sizeof(std::pair<int, int>);
+    constexpr std::size_t row_bytes = 3 * sizeof(std::size_t);
+    const std::size_t most_entries = symmetric ? 2 * m : m;
+    std::vector<int> block_starts{0};
+    std::vector<std::size_t> block_entries{most_entries};
+
+    if (most_entries * entry_bytes + static_cast<std::size_t>(n) * row_bytes > memory_limit) {
+        // Counting pass: adjacency entries (duplicates included) of every group of rows
+        constexpr int max_groups = 1 << 16;
+        const int group_rows = (n + max_groups - 1) / max_groups;
+        const int groups = (n + group_rows - 1) / group_rows;
+        std::vector<std::size_t> group_entries(static_cast<std::size_t>(groups), 0);
+        std::mutex merge;
+        parallel_blocks(m, threads, [&](const std::size_t begin, const std::size_t end) {
+            std::vector<std::size_t> local(group_entries.size(), 0);
+            for (std::size_t e = begin; e < end; e++) {
+                const GeneratedEdge edge = draw_edge<Weight>(spec, seed, n, e);
+                if (edge.u == edge.v) continue;
+                local[edge.u / group_rows]++;
+                if (symmetric) local[edge.v / group_rows]++;
+            }
+            std::lock_guard lock(merge);
+            for (std::size_t g = 0; g < local.size(); g++) group_entries[g] += local[g];
+        });
+        check_cancelled(token);
+
+        block_entries = {0};
+        std::size_t bytes = 0;
+        for (int g = 0; g < groups; g++) {
+            const int rows = std::min(n, (g + 1) * group_rows) - g * group_rows;
+            const std::size_t group_bytes = group_entries[g] * entry_bytes + static_cast<std::size_t>(rows) * row_bytes;
+            if (bytes > 0 && bytes + group_bytes > memory_limit) {
+                block_starts.push_back(g * group_rows);
+                block_entries.push_back(0);
+                bytes = 0;
+            }
+            bytes += group_bytes;
+            block_entries.back() += group_entries[g];
+        }
+    }
+    block_starts.push_back(n);
+    const int blocks = static_cast<int>(block_entries.size());
+    if (token) token->set_total(static_cast<std::size_t>(blocks));
+
+    RowBlock block;
+    for (int b = 0; b < blocks; b++) {
+        const int first = block_starts[b];
+        const int last = block_starts[b + 1];
+        const TrackedBytes tracked(MemoryCategory::AdjacencyList, block_entries[b] * entry_bytes
+                                                                  + static_cast<std::size_t>(last - first) * row_bytes);
+
+        // Draw all edges again and keep the entries of rows in [first, last)
+        std::vector<std::vector<GeneratedEdge>> parts;
+        std::mutex merge;
+        parallel_blocks(m, threads, [&](const std::size_t begin, const std::size_t end) {
+            std::vector<GeneratedEdge> local;
+            const double share = end > begin ? static_cast<double>(end - begin) / static_cast<double>(m) : 0.0;
+            local.reserve(static_cast<std::size_t>(share * static_cast<double>(block_entries[b])) + 64);
+            for (std::size_t e = begin; e < end; e++) {
+                const GeneratedEdge edge = draw_edge<Weight>(spec, seed, n, e);
+                if (edge.u == edge.v) continue;
+                if (edge.u >= first && edge.u < last) local.push_back(edge);
+                if (symmetric && edge.v >= first && edge.v < last) local.push_back({edge.v, edge.u, edge.weight});
+            }
+            std::lock_guard lock(merge);
+            parts.push_back(std::move(local));
+        });
+
+        std::vector<std::size_t> offsets(static_cast<std::size_t>(last - first) + 1, 0);
+        for (const auto& part : parts) {
+            for (const auto& edge : part) offsets[edge.u - first + 1]++;
+        }
+        for (std::size_t r = 1; r < offsets.size(); r++) offsets[r] += offsets[r - 1];
+
+        std::vector<std::pair<int, int>> entries(offsets.back());
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (auto& part : parts) {
+            for (const auto& [u, v, weight] : part) entries[fill[u - first]++] = {v, weight};
+            std::vector<GeneratedEdge>().swap(part);
+        }
+        parts.clear();
+        fill = {};
+
+        block.first_row = first;
+        collect_block_rows(block, entries, offsets, Weight::value, threads);
+        entries = {};
+        sink(block);
+
+        if (token) token->advance();
+        check_cancelled(token);
+    }
+    return blocks;
+}
+
+void write_edge_list(std::ostream &out, const RowBlock &block, const bool directed, unsigned int threads) {
+    // Rows are formatted in rounds of one slice per thread; all slices' text (at most line_bytes
+    // per entry) is kept within what the memory budget leaves free
+    constexpr std::size_t max_slice_entries = 1 << 20;
+    constexpr std::size_t min_slice_entries = 1 << 10;
+    constexpr std::size_t line_bytes = 3 * std::numeric_limits<int>::digits10 + 6;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t slice_entries = std::clamp<std::size_t>(get_free_memory_budget() / threads / line_bytes,
+                                                              min_slice_entries, max_slice_entries);
+    const TrackedBytes tracked(MemoryCategory::AdjacencyList, slice_entries * line_bytes * threads);
+
+    std::vector<std::string> texts(threads);
+    std::vector<std::pair<int, int>> slices;
+    int row = 0;
+    while (row < block.rows()) {
+        slices.clear();
+        while (slices.size() < threads && row < block.rows()) {
+            int end = row;
+            std::size_t entries = 0;
+            while (end < block.rows() && entries < slice_entries) {
+                entries += block.offsets[end + 1] - block.offsets[end];
+                end++;
+            }
+            slices.emplace_back(row, end);
+            row = end;
+        }
+
+        std::vector<std::thread> pool;
+        pool.reserve(slices.size() - 1);
+        for (std::size_t s = 1; s < slices.size(); s++) {
+            pool.emplace_back([&, s] { format_rows(texts[s], block, slices[s].first, slices[s].second, directed); });
+        }
+        format_rows(texts[0], block, slices[0].first, slices[0].second, directed);
+        for (auto& thread : pool) thread.join();
+
+        for (std::size_t s = 0; s < slices.size(); s++) out.write(texts[s].data(), static_cast<std::streamsize>(texts[s].size()));
+    }
+}
+
+template int stream_model_graph<Unweighted, Undirected>(const ModelSpec &, std::size_t, unsigned int,
+                                                        const std::function<void(const RowBlock&)> &, CancelToken *);
+template int stream_model_graph<Unweighted, Directed>(const ModelSpec &, std::size_t, unsigned int,
+                                                      const std::function<void(const RowBlock&)> &, CancelToken *);
+template int stream_model_graph<Weighted, Undirected>(const ModelSpec &, std::size_t, unsigned int,
+                                                      const std::function<void(const RowBlock&)> &, CancelToken *);
+template int stream_model_graph<Weighted, Directed>(const ModelSpec &, std::size_t, unsigned int,
+                                                    const std::function<void(const RowBlock&)> &, CancelToken *);
@@ -1,12 +1,17 @@
 // Created by IWOFLEUR on 19.10.2025
 
 #include "../../include/backend/graph_gen.h"
+#include "../../include/backend/memory_tracker.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <queue>
+#include <stdexcept>
+#include <tuple>
 
-Graph create_graph(const int n, const double edgeProb, const double loopProb,
-                   const unsigned int seed, const bool weighted, const bool directed) {
+template <typename Weight, typename Direction>
+Graph create_graph(const int n, const double edgeProb, const double loopProb, const unsigned int seed) {
     Graph graph;
     graph.n = n;
 
@@ -16,9 +21,6 @@ Graph create_graph(const int n, const double edgeProb, const double loopProb,
         graph.adj_matrix[i] = new int[n](); // Zero-initialize
     }
 
-    // List initialization
-    graph.adj_list.resize(n);
-
     // Random generator initialization
     static unsigned int counter = 0;
     const auto now = std::chrono::high_resolution_clock::now();
@@ -36,35 +38,128 @@ Graph create_graph(const int n, const double edgeProb, const double loopProb,
         return (static_cast<int>(state) % 10) + 1;
     };
 
-    // Process all possible edges
-    for (int i = 0; i < n; i++) {
-        for (int j = directed ? 0 : i; j < n; j++) {
-            if (!directed && j < i) continue;
+    const int edge_threshold = static_cast<int>(edgeProb * 100);
+    const int loop_threshold = static_cast<int>(loopProb * 100);
 
-            const bool is_loop = (i == j);
-            const double probability = is_loop ? loopProb : edgeProb;
+    auto add_edge = [&](const int i, const int j) {
+        if (next_rand() >= edge_threshold) return;
+        const int weight = Weight::value ? next_weight() : 1;
 
-            if (next_rand() >= static_cast<int>(probability * 100)) {
-                continue;
-            }
+        // Set matrix value
+        graph.adj_matrix[i][j] = weight;
 
-            const int weight = weighted ? next_weight() : 1;
+        // For undirected graphs, set symmetric value
+        if constexpr (!Direction::value) graph.adj_matrix[j][i] = weight;
+    };
 
-            // Set matrix value
-            graph.adj_matrix[i][j] = weight;
-            graph.adj_list[i].emplace_back(j, weight);
+    auto add_loop = [&](const int i) {
+        if (next_rand() >= loop_threshold) return;
+        const int weight = Weight::value ? next_weight() : 1;
+        graph.adj_matrix[i][i] = weight;
+    };
 
-            // For undirected graphs, set symmetric value
-            if (!directed && !is_loop) {
-                graph.adj_matrix[j][i] = weight;
-                graph.adj_list[j].emplace_back(i, weight);
-            }
+    // Process all possible edges; the diagonal is split out of the inner loops so they
+    // stay branch-free, but pairs are visited in the same order as a plain row scan
+    for (int i = 0; i < n; i++) {
+        if constexpr (Direction::value) {
+            for (int j = 0; j < i; j++) add_edge(i, j);
         }
+        add_loop(i);
+        for (int j = i + 1; j < n; j++) add_edge(i, j);
     }
 
+    // List: one row scan per vertex yields neighbours in increasing id order
+    graph.adj_list = make_adjacency_storage(n, Weight::value);
+    std::visit([&graph, n](auto& adj) {
+        std::size_t entries = 0;
+        for (int i = 0; i < n; i++) entries += n - std::count(graph.adj_matrix[i], graph.adj_matrix[i] + n, 0);
+        adj.offsets.reserve(static_cast<std::size_t>(n) + 1);
+        adj.targets.reserve(entries);
+        if constexpr (std::decay_t<decltype(adj)>::has_weights) adj.weights.reserve(entries);
+
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (graph.adj_matrix[i][j] != 0) adj.push(j, graph.adj_matrix[i][j]);
+            }
+            adj.end_row();
+        }
+    }, graph.adj_list);
+
+    track_allocation(MemoryCategory::AdjacencyMatrix, graph_matrix_bytes(graph));
+    track_allocation(MemoryCategory::AdjacencyList, graph_list_bytes(graph));
+
     return graph;
 }
 
+Graph copy_graph(const Graph &graph) {
+    Graph copy;
+    copy.n = graph.n;
+    copy.adj_list = graph.adj_list;
+    copy.adj_matrix = nullptr;
+    copy.original_id = graph.original_id;
+    copy.internal_id = graph.internal_id;
+
+    if (graph.adj_matrix != nullptr) {
+        copy.adj_matrix = new int*[graph.n];
+        for (int i = 0; i < graph.n; i++) {
+            copy.adj_matrix[i] = new int[graph.n];
+            std::copy_n(graph.adj_matrix[i], graph.n, copy.adj_matrix[i]);
+        }
+    }
+
+    track_allocation(MemoryCategory::AdjacencyMatrix, graph_matrix_bytes(copy));
+    track_allocation(MemoryCategory::AdjacencyList, graph_list_bytes(copy));
+
+    return copy;
+}
+
+std::shared_ptr<Graph> make_shared_graph(Graph graph) {
+    return {new Graph(std::move(graph)), [](Graph *g) {
+        delete_graph(*g, g->n);
+        delete g;
+    }};
+}
+
+std::size_t graph_matrix_bytes(const Graph &graph) {
+    if (graph.adj_matrix == nullptr) return 0;
+    const auto count = static_cast<std::size_t>(graph.n);
+    return count * count * sizeof(int) + count * sizeof(int*);
+}
+
+std::size_t graph_list_bytes(const Graph &graph) {
+    return std::visit([](const auto& adj) { return adj.bytes(); }, graph.adj_list);
+}
+
+namespace {
+    std::uint64_t mix(std::uint64_t x) {
+        // splitmix64 finaliser
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+}
+
+FingerprintBuilder::FingerprintBuilder(const int n) : sum(mix(static_cast<std::uint64_t>(n))) {}
+
+void FingerprintBuilder::add(const int from, const int to, const int weight) {
+    const auto key = static_cast<std::uint64_t>(from) << 32 | static_cast<std::uint64_t>(to);
+    sum += mix(key ^ mix(static_cast<std::uint64_t>(weight)));
+}
+
+std::uint64_t graph_fingerprint(const Graph &graph) {
+    FingerprintBuilder builder(graph.n);
+    std::visit([&](const auto& adj) {
+        for (int x = 0; x < adj.size(); x++) {
+            const int from = original_vertex(graph, x);
+            adj.for_each_neighbour(x, [&](const int y, const int weight) {
+                builder.add(from, original_vertex(graph, y), weight);
+            });
+        }
+    }, graph.adj_list);
+    return builder.value();
+}
+
 void print_matrix(int **matrix, const int rows, const int cols, const char *name) {
     if (!matrix || rows <= 0 || cols <= 0) {
         std::cout << "Invalid matrix parameters" << std::endl;
@@ -107,78 +202,219 @@ void print_matrix(int **matrix, const int rows, const int cols, const char *name
         for (int j = 0; j < cols; j++) {
             std::cout << std::setw(max_num_width + 1) << matrix[i][j];
         }
-        std::cout << std::endl;
+        std::cout << '\n';
     }
 }
 
 void delete_graph(Graph& graph, const int n) {
-    for (int i = 0; i < n; i++) {
-        delete[] graph.adj_matrix[i];
+    // Graphs from sparse generators may have no matrix, but always have a list
+    track_deallocation(MemoryCategory::AdjacencyList, graph_list_bytes(graph));
+    if (graph.adj_matrix != nullptr) {
+        track_deallocation(MemoryCategory::AdjacencyMatrix, graph_matrix_bytes(graph));
+
+        for (int i = 0; i < n; i++) {
+            delete[] graph.adj_matrix[i];
+        }
+        delete[] graph.adj_matrix;
     }
-    delete[] graph.adj_matrix;
     graph.adj_matrix = nullptr;
     graph.n = 0;
-    graph.adj_list.resize(0);
+    graph.adj_list = AdjacencyStorage{};
 }
 
-void print_list(const std::vector<std::vector<std::pair<int, int>>> &list, const char* name) {
+void print_list(const Graph &graph, const char* name) {
     std::cout << name << ":" << std::endl;
-    for (int i = 0; i < static_cast<int>(list.size()); i++) {
-        std::cout << i << ": ";
-        for (const auto&[fst, snd] : list[i]) {
-            std::cout << "(" << fst << ", " << snd << ") ";
+    std::visit([](const auto& adj) {
+        for (int i = 0; i < adj.size(); i++) {
+            std::cout << i << ": ";
+            adj.for_each_neighbour(i, [](const int fst, const int snd) {
+                std::cout << "(" << fst << ", " << snd << ") ";
+            });
+            std::cout << '\n';
         }
-        std::cout << std::endl;
-    }
+    }, graph.adj_list);
 }
 
-std::vector<int> find_distances(const Graph &graph, const int start_v) {
+template <typename Weight>
+std::vector<int> find_distances(const Graph &graph, const int start_v, std::ostream *order_out,
+                                const CancelToken *token, std::vector<int> *parents) {
+    if (start_v < 0 || start_v >= graph.n) {
+        throw std::out_of_range("start vertex " + std::to_string(start_v) + " is out of range");
+    }
+
     std::vector<int> distances(graph.n, -1);
-    BFSD(graph, start_v, distances);
-    return distances;
+    BFSD<Weight>(graph, internal_vertex(graph, start_v), distances, order_out, token, parents);
+    if (graph.original_id.empty()) return distances;
+
+    std::vector<int> by_original(graph.n);
+    for (int v = 0; v < graph.n; v++) by_original[graph.original_id[v]] = distances[v];
+    if (parents != nullptr) {
+        std::vector<int> parents_by_original(graph.n);
+        for (int v = 0; v < graph.n; v++) {
+            const int parent = (*parents)[v];
+            parents_by_original[graph.original_id[v]] = parent == -1 ? -1 : graph.original_id[parent];
+        }
+        parents->swap(parents_by_original);
+    }
+    return by_original;
+}
+
+template <typename Weight>
+void BFSD(const Graph &graph, const int start_v, std::vector<int> &DIST, std::ostream *order_out,
+          const CancelToken *token, std::vector<int> *PARENT) {
+    if (PARENT != nullptr) PARENT->assign(graph.n, -1);
+
+    std::visit([&](const auto& adj) {
+        std::queue<int> q;
+        q.push(start_v);
+        DIST[start_v] = 0;
+
+        while (!q.empty()) {
+            const int curr_v = q.front();
+
+            q.pop();
+            check_cancelled(token);
+            if (order_out != nullptr) *order_out << original_vertex(graph, curr_v) << " ";
+            // Neighbour lists are sorted by user-facing id, so this visits vertices in the same order as a matrix row scan
+            adj.for_each_neighbour(curr_v, [&](const int next_v, const int weight) {
+                if (DIST[next_v] == -1) {
+                    q.push(next_v);
+                    DIST[next_v] = DIST[curr_v] + (Weight::value ? weight : 1);
+                    if (PARENT != nullptr) (*PARENT)[next_v] = curr_v;
+                }
+            });
+        }
+    }, graph.adj_list);
+
+    if (order_out != nullptr) *order_out << std::endl;
 }
 
-void BFSD(const Graph &graph, const int start_v, std::vector<int> &DIST) {
-    std::queue<int> q;
-    q.push(start_v);
-    DIST[start_v] = 0;
+template <typename Weight>
+NearestSources find_nearest_sources(const Graph &graph, const std::vector<int> &sources, const CancelToken *token) {
+    if (sources.empty()) throw std::invalid_argument("at least one source vertex is needed");
+    for (const int s : sources) {
+        if (s < 0 || s >= graph.n) throw std::out_of_range("source vertex " + std::to_string(s) + " is out of range");
+    }
 
-    while (!q.empty()) {
-        const int curr_v = q.front();
+    // Labels live in stored ids; a vertex's source is kept as its rank in the list so ties compare cheaply
+    std::vector<int> distance(graph.n, -1);
+    std::vector<int> rank(graph.n, -1);
+
+    std::visit([&](const auto& adj) {
+        if constexpr (Weight::value) {
+            using Entry = std::tuple<int, int, int>; // distance, source rank, vertex
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+            for (int r = 0; r < static_cast<int>(sources.size()); r++) {
+                const int v = internal_vertex(graph, sources[r]);
+                if (distance[v] == -1) {
+                    distance[v] = 0;
+                    rank[v] = r;
+                    heap.emplace(0, r, v);
+                }
+            }
 
-        q.pop();
-        std::cout << curr_v << " ";
-        for (int i = 0; i < graph.n; i++) {
-            if (graph.adj_matrix[curr_v][i] > 0 && DIST[i] == -1) {
-                q.push(i);
-                DIST[i] = DIST[curr_v] + graph.adj_matrix[curr_v][i];
+            while (!heap.empty()) {
+                const auto [d, r, curr_v] = heap.top();
+                heap.pop();
+                if (d != distance[curr_v] || r != rank[curr_v]) continue;
+                check_cancelled(token);
+
+                adj.for_each_neighbour(curr_v, [&](const int next_v, const int weight) {
+                    const int candidate = d + weight;
+                    if (distance[next_v] == -1 || candidate < distance[next_v]
+                        || (candidate == distance[next_v] && r < rank[next_v])) {
+                        distance[next_v] = candidate;
+                        rank[next_v] = r;
+                        heap.emplace(candidate, r, next_v);
+                    }
+                });
+            }
+        } else {
+            // Levels keep the order of the sources, so the first source to reach a vertex is also the first listed
+            std::queue<int> q;
+            for (int r = 0; r < static_cast<int>(sources.size()); r++) {
+                const int v = internal_vertex(graph, sources[r]);
+                if (distance[v] == -1) {
+                    distance[v] = 0;
+                    rank[v] = r;
+                    q.push(v);
+                }
+            }
+
+            while (!q.empty()) {
+                const int curr_v = q.front();
+                q.pop();
+                check_cancelled(token);
+
+                adj.for_each_neighbour(curr_v, [&](const int next_v, int) {
+                    if (distance[next_v] == -1) {
+                        distance[next_v] = distance[curr_v] + 1;
+                        rank[next_v] = rank[curr_v];
+                        q.push(next_v);
+                    }
+                });
             }
         }
+    }, graph.adj_list);
+
+    NearestSources nearest;
+    nearest.distances.resize(graph.n);
+    nearest.sources.resize(graph.n);
+    for (int v = 0; v < graph.n; v++) {
+        const int user_v = original_vertex(graph, v);
+        nearest.distances[user_v] = distance[v];
+        nearest.sources[user_v] = rank[v] == -1 ? -1 : sources[rank[v]];
     }
-
-    std::cout << std::endl;
+    return nearest;
 }
 
-void print_distances(const std::vector<int> &DIST, const int start_v) {
-    std::cout << "Distances from vertex " << start_v << ":" << std::endl;
+void print_distance_tree(const std::vector<int> &DIST, const std::vector<int> &PARENT, const int start_v,
+                         std::ostream &out) {
+    out << "BFS tree from vertex " << start_v << ":" << std::endl;
     for (int i = 0; i < static_cast<int>(DIST.size()); i++) {
         if (DIST[i] == -1) {
-            std::cout << "Vertex " << i << ": unreachable" << std::endl;
+            out << "Vertex " << i << ": unreachable" << '\n';
+        } else if (PARENT[i] == -1) {
+            out << "Vertex " << i << ": " << DIST[i] << " (root)" << '\n';
         } else {
-            std::cout << "Vertex " << i << ": " << DIST[i] << std::endl;
+            out << "Vertex " << i << ": " << DIST[i] << " (parent " << PARENT[i] << ")" << '\n';
         }
     }
 }
 
-std::vector<std::vector<int> > build_distance_matrix(const Graph &graph) {
-    std::vector<std::vector<int> > distances(graph.n, std::vector<int>(graph.n, -1));
-    for (int i = 0; i < graph.n; i++) {
-        std::vector<int> dist_from_i(graph.n, -1);
-        BFSD(graph, i, dist_from_i);
-        distances[i] = dist_from_i;
+void print_nearest_sources(const NearestSources &nearest, std::ostream &out) {
+    out << "Nearest sources:" << std::endl;
+    for (int i = 0; i < static_cast<int>(nearest.distances.size()); i++) {
+        if (nearest.distances[i] == -1) {
+            out << "Vertex " << i << ": unreachable" << '\n';
+        } else {
+            out << "Vertex " << i << ": " << nearest.distances[i] << " (source " << nearest.sources[i] << ")" << '\n';
+        }
+    }
+}
+
+void print_distances(const std::vector<int> &DIST, const int start_v, std::ostream &out) {
+    out << "Distances from vertex " << start_v << ":" << std::endl;
+    for (int i = 0; i < static_cast<int>(DIST.size()); i++) {
+        if (DIST[i] == -1) {
+            out << "Vertex " << i << ": unreachable" << '\n';
+        } else {
+            out << "Vertex " << i << ": " << DIST[i] << '\n';
+        }
     }
+}
+
+template <typename Weight>
+std::vector<std::vector<int> > build_distance_matrix(const Graph &graph, CancelToken *token) {
+    return build_distance_matrix<Weight>(graph, find_connected_components(graph), token);
+}
 
-    return distances;
+template <typename Weight>
+std::vector<std::vector<int> > build_distance_matrix(const Graph &graph, const ComponentInfo &components,
+                                                     CancelToken *token) {
+    AnalysisOptions options;
+    options.engine = DistanceEngine::Bfs;
+    return compute_distance_matrix<Weight>(graph, components, options, token);
 }
 
 std::vector<int> compute_eccentricities(const std::vector<std::vector<int> > &dist_matrix) {
@@ -245,33 +481,158 @@ std::vector<int> find_peripheral_vertices(const std::vector<int> &ecc, const int
     return peripheral_vertices;
 }
 
-void print_distance_matrix(const std::vector<std::vector<int>> &dist_matrix) {
-    const int n = static_cast<int>(dist_matrix.size());
-    constexpr int cell_width = 4;
-
-    std::cout << "Distances matrix:" << std::endl;
-    std::cout << std::setw(cell_width + 1) << " ";
-    for (int j = 0; j < n; j++) {
-        std::cout << std::setw(cell_width) << j << " ";
+template <typename Weight>
+AnalysisResult analyse_graph(const Graph &graph, CancelToken *token, const AnalysisOptions &options) {
+    AnalysisResult result;
+    result.components = find_connected_components(graph);
+
+    if (!options.matrix_file.empty()) {
+        // Rows go straight to disk in user-facing order; eccentricities are taken on the way. Until
+        // commit() they go to a temporary file, removed again if the analysis fails or is cancelled
+        auto file = DistanceMatrixFile::create(options.matrix_file, graph.n, options.keep_matrix_file);
+        result.eccentricities.assign(graph.n, -1);
+        compute_distance_rows<Weight>(graph, result.components, options, [&](const int source, const std::span<const int> row) {
+            const int v = original_vertex(graph, source);
+            const std::span<int> out = file->mutable_row(v);
+            if (graph.original_id.empty()) std::ranges::copy(row, out.begin());
+            else for (int u = 0; u < graph.n; u++) out[graph.original_id[u]] = row[u];
+            result.eccentricities[v] = std::ranges::max(row);
+            file->flush_rows(v, 1);
+        }, token);
+        file->sync();
+        file->commit();
+        result.dist_file = std::move(file);
+        if (!graph.original_id.empty()) result.components = relabel_components(result.components, graph.original_id);
+    } else {
+        result.tracked = TrackedBytes(MemoryCategory::DistanceMatrix, estimate_distance_matrix_footprint(graph.n));
+        result.dist_matrix = compute_distance_matrix<Weight>(graph, result.components, options, token);
+
+        if (!graph.original_id.empty()) {
+            // Back to user-facing ids: rows move by handle, columns are permuted through one scratch row
+            std::vector<std::vector<int>> rows(graph.n);
+            for (int v = 0; v < graph.n; v++) rows[graph.original_id[v]] = std::move(result.dist_matrix[v]);
+            result.dist_matrix = std::move(rows);
+
+            std::vector<int> scratch(graph.n);
+            for (auto& row : result.dist_matrix) {
+                for (int v = 0; v < graph.n; v++) scratch[graph.original_id[v]] = row[v];
+                row.swap(scratch);
+            }
+            result.components = relabel_components(result.components, graph.original_id);
+        }
+        result.eccentricities = compute_eccentricities(result.dist_matrix);
     }
-    std::cout << std::endl;
 
-    std::cout << std::setw(cell_width) <<  "  +";
-    for (int j = 0; j <= n; j++) {
-        std::cout << std::string(cell_width + 1, '-');
-    }
-    std::cout << std::endl;
+    const DistanceEngine engine = select_distance_engine<Weight>(graph, options.engine);
+    result.shortest_paths = !Weight::value || engine == DistanceEngine::Dijkstra || engine == DistanceEngine::Floyd;
 
-    for (int i = 0; i < n; i++) {
-        if (i > 9) std::cout << i << std::setw(cell_width - 1) << "| ";
-        else std::cout << i << std::setw(cell_width) << " | ";
+    result.radius = compute_radius(result.eccentricities);
+    result.diameter = compute_diameter(result.eccentricities);
+    result.central = find_central_vertices(result.eccentricities, result.radius);
+    result.peripheral = find_peripheral_vertices(result.eccentricities, result.diameter);
+    result.component_summary = summarize_components(result.components, result.eccentricities);
+    return result;
+}
+
+namespace {
+    template <typename RowOf>
+    void print_distance_rows(const int n, RowOf row_of, std::ostream &out) {
+        constexpr int cell_width = 4;
+
+        out << "Distances matrix:" << std::endl;
+        out << std::setw(cell_width + 1) << " ";
         for (int j = 0; j < n; j++) {
-            if (dist_matrix[i][j] == -1) {
-                std::cout << std::setw(cell_width) << "inf" << " ";
-            } else {
-                std::cout << std::setw(cell_width) << dist_matrix[i][j] << " ";
+            out << std::setw(cell_width) << j << " ";
+        }
+        out << std::endl;
+
+        out << std::setw(cell_width) <<  "  +";
+        for (int j = 0; j <= n; j++) {
+            out << std::string(cell_width + 1, '-');
+        }
+        out << std::endl;
+
+        for (int i = 0; i < n; i++) {
+            const auto& row = row_of(i);
+            if (i > 9) out << i << std::setw(cell_width - 1) << "| ";
+            else out << i << std::setw(cell_width) << " | ";
+            for (int j = 0; j < n; j++) {
+                if (row[j] == -1) {
+                    out << std::setw(cell_width) << "inf" << " ";
+                } else {
+                    out << std::setw(cell_width) << row[j] << " ";
+                }
             }
+            out << '\n';
         }
-        std::cout << std::endl;
     }
 }
+
+void print_distance_matrix(const std::vector<std::vector<int>> &dist_matrix, std::ostream &out) {
+    print_distance_rows(static_cast<int>(dist_matrix.size()), [&dist_matrix](const int i) -> const std::vector<int>& {
+        return dist_matrix[i];
+    }, out);
+}
+
+void print_distance_matrix(const DistanceMatrixFile &dist_file, std::ostream &out) {
+    dist_file.advise_sequential();
+    print_distance_rows(dist_file.size(), [&dist_file](const int i) { return dist_file.row(i); }, out);
+}
+
+std::span<const int> distance_row(const AnalysisResult &result, const int v) {
+    if (result.dist_file != nullptr) return result.dist_file->row(v);
+    return result.dist_matrix[v];
+}
+
+std::vector<int> path_from_distances(const Graph &graph, const AnalysisResult &result, const int u, const int v) {
+    if (!result.shortest_paths) throw std::logic_error("analysis distances are not shortest paths");
+    if (u < 0 || u >= graph.n || v < 0 || v >= graph.n) {
+        throw std::out_of_range("vertex out of range 0.." + std::to_string(graph.n - 1));
+    }
+    if (distance_row(result, u)[v] == -1) return {};
+
+    std::vector<int> path{u};
+    std::visit([&](const auto& adj) {
+        for (int x = u; x != v;) {
+            const int remaining = distance_row(result, x)[v];
+            const int stored_x = internal_vertex(graph, x);
+            int next = -1;
+            for (std::size_t edge = adj.offsets[stored_x]; edge < adj.offsets[stored_x + 1] && next == -1; edge++) {
+                const int y = original_vertex(graph, static_cast<int>(adj.targets[edge]));
+                const int rest = distance_row(result, y)[v];
+                if (y != x && rest != -1 && rest + adj.weight(edge) == remaining) next = y;
+            }
+            if (next == -1) throw std::logic_error("analysis distances do not match the graph");
+            path.push_back(next);
+            x = next;
+        }
+    }, graph.adj_list);
+    return path;
+}
+
+// Explicit instantiations for every policy combination used by the console
+
+template Graph create_graph<Unweighted, Undirected>(int, double, double, unsigned int);
+template Graph create_graph<Unweighted, Directed>(int, double, double, unsigned int);
+template Graph create_graph<Weighted, Undirected>(int, double, double, unsigned int);
+template Graph create_graph<Weighted, Directed>(int, double, double, unsigned int);
+
+template std::vector<int> find_distances<Unweighted>(const Graph &, int, std::ostream *, const CancelToken *,
+                                                     std::vector<int> *);
+template std::vector<int> find_distances<Weighted>(const Graph &, int, std::ostream *, const CancelToken *,
+                                                   std::vector<int> *);
+template NearestSources find_nearest_sources<Unweighted>(const Graph &, const std::vector<int> &, const CancelToken *);
+template NearestSources find_nearest_sources<Weighted>(const Graph &, const std::vector<int> &, const CancelToken *);
+
+template void BFSD<Unweighted>(const Graph &, int, std::vector<int> &, std::ostream *, const CancelToken *,
+                               std::vector<int> *);
+template void BFSD<Weighted>(const Graph &, int, std::vector<int> &, std::ostream *, const CancelToken *,
+                             std::vector<int> *);
+
+template std::vector<std::vector<int> > build_distance_matrix<Unweighted>(const Graph &, CancelToken *);
+template std::vector<std::vector<int> > build_distance_matrix<Weighted>(const Graph &, CancelToken *);
+template std::vector<std::vector<int> > build_distance_matrix<Unweighted>(const Graph &, const ComponentInfo &, CancelToken *);
+template std::vector<std::vector<int> > build_distance_matrix<Weighted>(const Graph &, const ComponentInfo &, CancelToken *);
+
+template AnalysisResult analyse_graph<Unweighted>(const Graph &, CancelToken *, const AnalysisOptions &);
+template AnalysisResult analyse_graph<Weighted>(const Graph &, CancelToken *, const AnalysisOptions &);
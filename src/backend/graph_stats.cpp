@@ -0,0 +1,120 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/graph_stats.h"
+
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <numeric>
+
+#include "../../include/backend/graph_gen.h"
+#include "../../include/backend/graph_policies.h"
+
+namespace {
+    /**
+     * Summarises n degrees given by degree_of(v). Minimum, maximum and sum
+     * are one branch-free loop (vectorised by the compiler), the histogram a
+     * second one.
+     */
+    template <typename DegreeOf>
+    DegreeSummary summarize_degrees(const int n, DegreeOf degree_of) {
+        DegreeSummary summary;
+        if (n == 0) return summary;
+
+        std::size_t low = degree_of(0);
+        std::size_t high = low;
+        std::size_t total = 0;
+        for (int v = 0; v < n; v++) {
+            const std::size_t d = degree_of(v);
+            low = std::min(low, d);
+            high = std::max(high, d);
+            total += d;
+        }
+
+        summary.min = low;
+        summary.max = high;
+        summary.mean = static_cast<double>(total) / n;
+        summary.histogram.assign(std::bit_width(high) + 1, 0);
+        for (int v = 0; v < n; v++) summary.histogram[std::bit_width(degree_of(v))]++;
+        return summary;
+    }
+
+    void print_degrees(const char* title, const DegreeSummary &summary, std::ostream &out) {
+        out << title << ": min " << summary.min << ", max " << summary.max << ", mean " << std::fixed
+            << std::setprecision(2) << summary.mean << std::defaultfloat << std::endl;
+        for (std::size_t bucket = 0; bucket < summary.histogram.size(); bucket++) {
+            if (summary.histogram[bucket] == 0) continue;
+            if (bucket == 0) out << "  0: ";
+            else if (bucket == 1) out << "  1: ";
+            else out << "  " << (std::size_t{1} << (bucket - 1)) << "-" << (std::size_t{1} << bucket) - 1 << ": ";
+            out << summary.histogram[bucket] << '\n';
+        }
+    }
+}
+
+template <typename Direction>
+GraphStats compute_graph_stats(const Graph &graph) {
+    GraphStats stats;
+    stats.vertices = graph.n;
+    stats.directed = Direction::value;
+
+    std::visit([&](const auto& adj) {
+        using Adjacency = std::decay_t<decltype(adj)>;
+        const int n = adj.size();
+        const std::size_t entries = adj.edge_count();
+
+        stats.degree = summarize_degrees(n, [&](const int v) { return adj.offsets[v + 1] - adj.offsets[v]; });
+
+        // One scan over the targets finds loops and, for directed graphs, in-degrees
+        std::vector<std::size_t> in_degree(Direction::value ? n : 0, 0);
+        for (int v = 0; v < n; v++) {
+            const auto row = adj.neighbours(v);
+            stats.loops += static_cast<std::size_t>(std::ranges::count(row, static_cast<typename Adjacency::vertex_type>(v)));
+            if constexpr (Direction::value) {
+                for (const auto target : row) in_degree[target]++;
+            }
+        }
+        if constexpr (Direction::value) {
+            stats.in_degree = summarize_degrees(n, [&](const int v) { return in_degree[v]; });
+        }
+
+        stats.edges = Direction::value ? entries : (entries - stats.loops) / 2 + stats.loops;
+
+        if constexpr (Adjacency::has_weights) {
+            stats.weighted = true;
+            if (!adj.weights.empty()) {
+                const auto [low, high] = std::ranges::minmax(adj.weights);
+                stats.weight_min = low;
+                stats.weight_max = high;
+                stats.weight_mean = static_cast<double>(std::accumulate(adj.weights.begin(), adj.weights.end(),
+                                                                        std::size_t{0})) / static_cast<double>(entries);
+            }
+        }
+    }, graph.adj_list);
+
+    if (graph.n > 1) {
+        const double pairs = static_cast<double>(graph.n) * (graph.n - 1) / (Direction::value ? 1.0 : 2.0);
+        stats.density = static_cast<double>(stats.edges - stats.loops) / pairs;
+    }
+    return stats;
+}
+
+void print_graph_stats(const GraphStats &stats, std::ostream &out) {
+    // Means are printed with two decimals; the caller's precision is restored at the end
+    const std::streamsize precision = out.precision();
+    out << "Vertices: " << stats.vertices << std::endl;
+    out << "Edges: " << stats.edges << (stats.directed ? " (directed)" : " (undirected)") << std::endl;
+    out << "Loops: " << stats.loops << std::endl;
+    out << "Density: " << std::setprecision(6) << stats.density << std::endl;
+    print_degrees(stats.directed ? "Out-degree" : "Degree", stats.degree, out);
+    if (stats.directed) print_degrees("In-degree", stats.in_degree, out);
+    if (stats.weighted && stats.edges > 0) {
+        out << "Weights: min " << stats.weight_min << ", max " << stats.weight_max << ", mean " << std::fixed
+            << std::setprecision(2) << stats.weight_mean << std::defaultfloat << std::endl;
+    }
+    out.precision(precision);
+    out << std::flush;
+}
+
+template GraphStats compute_graph_stats<Directed>(const Graph &);
+template GraphStats compute_graph_stats<Undirected>(const Graph &);
@@ -0,0 +1,92 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/graph_workspace.h"
+
+#include <cctype>
+
+std::uint64_t GraphWorkspace::put(const std::string &name, std::shared_ptr<const Graph> graph) {
+    const std::uint64_t new_version = next_version++;
+    entries[name] = {std::move(graph), new_version};
+    if (current.empty()) current = name;
+    return new_version;
+}
+
+std::shared_ptr<const Graph> GraphWorkspace::get(const std::string &name) const {
+    const auto it = entries.find(name);
+    return it != entries.end() ? it->second.snapshot : nullptr;
+}
+
+std::uint64_t GraphWorkspace::version(const std::string &name) const {
+    const auto it = entries.find(name);
+    return it != entries.end() ? it->second.version : 0;
+}
+
+bool GraphWorkspace::contains(const std::string &name) const {
+    return entries.contains(name);
+}
+
+bool GraphWorkspace::use(const std::string &name) {
+    if (!entries.contains(name)) return false;
+    current = name;
+    return true;
+}
+
+bool GraphWorkspace::drop(const std::string &name) {
+    if (entries.erase(name) == 0) return false;
+    if (current == name) current = entries.empty() ? "" : entries.begin()->first;
+    return true;
+}
+
+bool GraphWorkspace::clone(const std::string &src, const std::string &dst) {
+    const auto it = entries.find(src);
+    if (it == entries.end()) return false;
+
+    // Same snapshot, same content: keep the version so cached results stay valid
+    entries[dst] = it->second;
+    return true;
+}
+
+bool GraphWorkspace::modify(const std::string &name, const std::function<void(Graph &)> &modify) {
+    const auto it = entries.find(name);
+    if (it == entries.end()) return false;
+
+    Entry& entry = it->second;
+    std::shared_ptr<Graph> writable;
+    if (entry.snapshot.use_count() == 1) {
+        // Sole owner: the snapshot is not visible to anyone else, so it can change in place
+        writable = std::const_pointer_cast<Graph>(entry.snapshot);
+    } else {
+        writable = make_shared_graph(copy_graph(*entry.snapshot));
+    }
+
+    modify(*writable);
+    entry.snapshot = std::move(writable);
+    entry.version = next_version++;
+    return true;
+}
+
+void GraphWorkspace::clear() {
+    entries.clear();
+    current.clear();
+}
+
+std::vector<GraphWorkspace::EntryInfo> GraphWorkspace::list() const {
+    std::vector<EntryInfo> result;
+    result.reserve(entries.size());
+    for (const auto& [name, entry] : entries) {
+        const Graph& graph = *entry.snapshot;
+        result.push_back({name, graph.n, graph_matrix_bytes(graph) + graph_list_bytes(graph),
+                          entry.snapshot.use_count(), entry.version, name == current});
+    }
+    return result;
+}
+
+bool GraphWorkspace::is_valid_name(const std::string &name) {
+    if (name.empty()) return false;
+    if (!std::isalpha(static_cast<unsigned char>(name[0])) && name[0] != '_') return false;
+
+    for (const char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-') return false;
+    }
+    return true;
+}
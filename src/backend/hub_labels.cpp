@@ -0,0 +1,314 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/hub_labels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "../../include/backend/graph_gen.h"
+#include "../../include/backend/graph_policies.h"
+#include "../../include/backend/point_queries.h"
+
+namespace {
+    constexpr char magic[4] = {'G', 'H', 'L', '1'};
+    constexpr std::uint32_t directed_flag = 1;
+    constexpr std::uint32_t weighted_flag = 2;
+
+    struct FileHeader {
+        char magic[4];
+        std::uint32_t flags;
+        std::int64_t n;
+        std::uint64_t fingerprint;
+        std::uint64_t out_entries;
+        std::uint64_t in_entries;
+    };
+    static_assert(sizeof(FileHeader) == 40);
+
+    constexpr int uncovered = std::numeric_limits<int>::max();
+
+    using Label = std::vector<std::pair<int, int>>; ///< (hub rank, distance), in increasing rank
+
+    struct PruneBuffers {
+        std::vector<int> dist;     ///< Search labels, all -1 between searches
+        std::vector<int> hub_dist; ///< Distance between the root and every hub of its label, by rank
+        std::vector<int> visited;
+        std::vector<std::pair<int, int>> heap;
+    };
+
+    /// True if the hubs of label, combined with the root's hubs, already give a distance <= d
+    bool covered(const Label &label, const std::vector<int> &hub_dist, const int d) {
+        for (const auto& [hub, hub_d] : label) {
+            if (hub_dist[hub] != uncovered && hub_dist[hub] + hub_d <= d) return true;
+        }
+        return false;
+    }
+
+    /**
+     * One pruned search of PLL: adds (rank, distance) to the label of every
+     * vertex whose distance from root the existing labels do not cover, and
+     * does not search past vertices that are covered. Returns the number of
+     * entries added.
+     */
+    template <typename Weight, typename Adjacency>
+    std::size_t pruned_search(const Adjacency &adj, const int root, const int rank, const Label &root_label,
+                              std::vector<Label> &labels, PruneBuffers &b) {
+        for (const auto& [hub, d] : root_label) b.hub_dist[hub] = d;
+        b.visited.assign(1, root);
+        b.dist[root] = 0;
+        std::size_t added = 0;
+
+        if constexpr (Weight::value && Adjacency::has_weights) {
+            b.heap.assign(1, {0, root});
+            while (!b.heap.empty()) {
+                std::ranges::pop_heap(b.heap, std::greater<>{});
+                const auto [d, x] = b.heap.back();
+                b.heap.pop_back();
+                if (d != b.dist[x] || covered(labels[x], b.hub_dist, d)) continue;
+                labels[x].emplace_back(rank, d);
+                added++;
+
+                adj.for_each_neighbour(x, [&](const int y, const int weight) {
+                    if (b.dist[y] == -1 || d + weight < b.dist[y]) {
+                        if (b.dist[y] == -1) b.visited.push_back(y);
+                        b.dist[y] = d + weight;
+                        b.heap.emplace_back(b.dist[y], y);
+                        std::ranges::push_heap(b.heap, std::greater<>{});
+                    }
+                });
+            }
+        } else {
+            // visited doubles as the BFS queue
+            for (std::size_t head = 0; head < b.visited.size(); head++) {
+                const int x = b.visited[head];
+                const int d = b.dist[x];
+                if (covered(labels[x], b.hub_dist, d)) continue;
+                labels[x].emplace_back(rank, d);
+                added++;
+
+                adj.for_each_neighbour(x, [&](const int y, int) {
+                    if (b.dist[y] == -1) {
+                        b.dist[y] = d + 1;
+                        b.visited.push_back(y);
+                    }
+                });
+            }
+        }
+
+        for (const int x : b.visited) b.dist[x] = -1;
+        for (const auto& [hub, d] : root_label) b.hub_dist[hub] = uncovered;
+        return added;
+    }
+
+    /// Flattens labels indexed by stored id into a LabelSet indexed by user-facing id
+    LabelSet flatten(const Graph &graph, const std::vector<Label> &labels) {
+        LabelSet set;
+        set.offsets.assign(static_cast<std::size_t>(graph.n) + 1, 0);
+        for (int v = 0; v < graph.n; v++) {
+            set.offsets[v + 1] = set.offsets[v] + labels[internal_vertex(graph, v)].size() + 1;
+        }
+        set.hubs.reserve(set.offsets.back());
+        set.distances.reserve(set.offsets.back());
+        for (int v = 0; v < graph.n; v++) {
+            for (const auto& [hub, d] : labels[internal_vertex(graph, v)]) {
+                set.hubs.push_back(hub);
+                set.distances.push_back(d);
+            }
+            set.hubs.push_back(hub_sentinel);
+            set.distances.push_back(0);
+        }
+        return set;
+    }
+
+    std::size_t label_bytes(const LabelSet &set) {
+        return set.offsets.size() * sizeof(std::uint64_t) + (set.hubs.size() + set.distances.size()) * sizeof(int);
+    }
+
+    template <typename T>
+    void write_array(std::ofstream &file, const std::vector<T> &data) {
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    void read_array(std::ifstream &file, std::vector<T> &data, const std::size_t count) {
+        data.resize(count);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+
+    void read_label_set(std::ifstream &file, LabelSet &set, const int n, const std::uint64_t entries,
+                        const std::string &path) {
+        read_array(file, set.offsets, static_cast<std::size_t>(n) + 1);
+        read_array(file, set.hubs, entries);
+        read_array(file, set.distances, entries);
+        if (!file) throw std::runtime_error("'" + path + "' is truncated");
+
+        // Every label must end in a sentinel, or a merge could run past it
+        bool valid = set.offsets.front() == 0 && set.offsets.back() == entries;
+        for (int v = 0; v < n && valid; v++) {
+            valid = set.offsets[v] < set.offsets[v + 1] && set.hubs[set.offsets[v + 1] - 1] == hub_sentinel;
+        }
+        if (!valid) throw std::runtime_error("'" + path + "' is not a valid hub label file");
+    }
+}
+
+double HubLabels::average_label_size() const {
+    if (n == 0) return 0.0;
+    const auto hubs = static_cast<double>(out.hubs.size() + in.hubs.size()) - (directed ? 2.0 : 1.0) * n;
+    return hubs / (directed ? 2.0 * n : n);
+}
+
+template <typename Weight, typename Direction>
+std::shared_ptr<const HubLabels> build_hub_labels(const Graph &graph, CancelToken *token) {
+    const int n = graph.n;
+    auto labels = std::make_shared<HubLabels>();
+    labels->n = n;
+    labels->directed = Direction::value;
+    labels->weighted = Weight::value;
+    labels->fingerprint = graph_fingerprint(graph);
+    if (token != nullptr) token->set_total(n);
+
+    std::vector<Label> out(n);
+    std::vector<Label> in(Direction::value ? n : 0);
+    PruneBuffers buffers;
+    buffers.dist.assign(n, -1);
+    buffers.hub_dist.assign(n, uncovered);
+
+    const auto reverse = Direction::value ? build_reverse_adjacency(graph) : nullptr;
+
+    std::visit([&](const auto& adj) {
+        // Highest degree first (in-degree included for directed graphs), ties by stored id
+        std::vector<std::size_t> degree(n);
+        for (int v = 0; v < n; v++) degree[v] = adj.degree(v);
+        if constexpr (Direction::value) {
+            for (const auto target : adj.targets) degree[target]++;
+        }
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&](const int a, const int b) { return degree[a] > degree[b]; });
+
+        using Adjacency = std::decay_t<decltype(adj)>;
+        const Adjacency* in_adj = reverse != nullptr ? &std::get<Adjacency>(reverse->adj) : nullptr;
+
+        std::size_t entries = 0;
+        for (int rank = 0; rank < n; rank++) {
+            const int v = order[rank];
+            check_cancelled(token);
+
+            if constexpr (Direction::value) {
+                // Forward search fills in-labels (d(v, x)), backward search out-labels (d(x, v))
+                entries += pruned_search<Weight>(adj, v, rank, out[v], in, buffers);
+                entries += pruned_search<Weight>(*in_adj, v, rank, in[v], out, buffers);
+            } else {
+                entries += pruned_search<Weight>(adj, v, rank, out[v], out, buffers);
+            }
+
+            if (token != nullptr) token->advance();
+            if (rank % 256 == 255 && !memory_budget_allows(entries * sizeof(Label::value_type))) {
+                throw std::length_error("hub labels exceed the memory budget after "
+                                        + std::to_string(rank + 1) + " of " + std::to_string(n) + " vertices");
+            }
+        }
+    }, graph.adj_list);
+
+    labels->out = flatten(graph, out);
+    if constexpr (Direction::value) labels->in = flatten(graph, in);
+    labels->tracked = TrackedBytes(MemoryCategory::Index, label_bytes(labels->out) + label_bytes(labels->in));
+    return labels;
+}
+
+int hub_distance(const HubLabels &labels, const int u, const int v) {
+    if (u == v) return 0;
+    const LabelSet& from = labels.out;
+    const LabelSet& to = labels.in_labels();
+    const int* from_hubs = from.hubs.data() + from.offsets[u];
+    const int* from_dist = from.distances.data() + from.offsets[u];
+    const int* to_hubs = to.hubs.data() + to.offsets[v];
+    const int* to_dist = to.distances.data() + to.offsets[v];
+
+    // Merge join of two sorted hub lists; the sentinels end both at once
+    int best = uncovered;
+    for (;;) {
+        const int a = *from_hubs;
+        const int b = *to_hubs;
+        if (a == b) {
+            if (a == hub_sentinel) break;
+            best = std::min(best, *from_dist + *to_dist);
+        }
+        // Branch-free advance: the smaller side moves, both move on a match
+        const bool advance_from = a <= b;
+        const bool advance_to = b <= a;
+        from_hubs += advance_from;
+        from_dist += advance_from;
+        to_hubs += advance_to;
+        to_dist += advance_to;
+    }
+    return best == uncovered ? -1 : best;
+}
+
+void save_hub_labels(const HubLabels &labels, const std::string &path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("cannot create '" + path + "'");
+
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.flags = (labels.directed ? directed_flag : 0) | (labels.weighted ? weighted_flag : 0);
+    header.n = labels.n;
+    header.fingerprint = labels.fingerprint;
+    header.out_entries = labels.out.hubs.size();
+    header.in_entries = labels.in.hubs.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const LabelSet* set : {&labels.out, &labels.in}) {
+        if (set->offsets.empty()) continue;
+        write_array(file, set->offsets);
+        write_array(file, set->hubs);
+        write_array(file, set->distances);
+    }
+    file.flush();
+    if (!file) throw std::runtime_error("cannot write '" + path + "'");
+}
+
+std::shared_ptr<const HubLabels> load_hub_labels(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("cannot open '" + path + "'");
+
+    FileHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const bool directed = (header.flags & directed_flag) != 0;
+    if (!file || std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.n <= 0 || header.n > INT32_MAX
+        || (!directed && header.in_entries != 0)) {
+        throw std::runtime_error("'" + path + "' is not a hub label file");
+    }
+
+    // Compare against the file size before allocating anything the header asks for
+    file.seekg(0, std::ios::end);
+    const auto file_size = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(sizeof(header));
+    const auto offset_bytes = (static_cast<std::uint64_t>(header.n) + 1) * sizeof(std::uint64_t);
+    const std::uint64_t entry_bytes = 2 * sizeof(int);
+    if (header.out_entries > file_size / entry_bytes || header.in_entries > file_size / entry_bytes
+        || file_size != sizeof(header) + offset_bytes * (directed ? 2 : 1)
+                        + (header.out_entries + header.in_entries) * entry_bytes) {
+        throw std::runtime_error("'" + path + "' is truncated or has trailing data");
+    }
+
+    auto labels = std::make_shared<HubLabels>();
+    labels->n = static_cast<int>(header.n);
+    labels->directed = directed;
+    labels->weighted = (header.flags & weighted_flag) != 0;
+    labels->fingerprint = header.fingerprint;
+    read_label_set(file, labels->out, labels->n, header.out_entries, path);
+    if (directed) read_label_set(file, labels->in, labels->n, header.in_entries, path);
+
+    labels->tracked = TrackedBytes(MemoryCategory::Index, label_bytes(labels->out) + label_bytes(labels->in));
+    return labels;
+}
+
+template std::shared_ptr<const HubLabels> build_hub_labels<Unweighted, Undirected>(const Graph &, CancelToken *);
+template std::shared_ptr<const HubLabels> build_hub_labels<Unweighted, Directed>(const Graph &, CancelToken *);
+template std::shared_ptr<const HubLabels> build_hub_labels<Weighted, Undirected>(const Graph &, CancelToken *);
+template std::shared_ptr<const HubLabels> build_hub_labels<Weighted, Directed>(const Graph &, CancelToken *);
@@ -0,0 +1,284 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/landmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "../../include/backend/graph_gen.h"
+#include "../../include/backend/graph_policies.h"
+#include "../../include/backend/task_pool.h"
+
+namespace {
+    using HeapEntry = std::pair<int, int>;
+
+    struct SearchBuffers {
+        std::vector<int> dist;  ///< All -1 between searches
+        std::vector<int> order; ///< Vertices labelled by the last search
+        std::vector<HeapEntry> heap;
+    };
+
+    /**
+     * Single-source shortest distances: BFS without weights, Dijkstra with.
+     * Leaves the labels in buffers.dist and the labelled vertices in buffers.order.
+     */
+    template <typename Weight, typename Adjacency>
+    void shortest_distances(const Adjacency &adj, const int source, SearchBuffers &buffers) {
+        auto& dist = buffers.dist;
+        auto& order = buffers.order;
+        if (dist.empty()) dist.assign(adj.size(), -1);
+        for (const int v : order) dist[v] = -1;
+        order.assign(1, source);
+        dist[source] = 0;
+
+        if constexpr (Weight::value && Adjacency::has_weights) {
+            auto& heap = buffers.heap;
+            heap.assign(1, {0, source});
+            while (!heap.empty()) {
+                std::ranges::pop_heap(heap, std::greater<>{});
+                const auto [d, x] = heap.back();
+                heap.pop_back();
+                if (d != dist[x]) continue;
+                adj.for_each_neighbour(x, [&](const int y, const int weight) {
+                    if (dist[y] == -1 || d + weight < dist[y]) {
+                        if (dist[y] == -1) order.push_back(y);
+                        dist[y] = d + weight;
+                        heap.emplace_back(dist[y], y);
+                        std::ranges::push_heap(heap, std::greater<>{});
+                    }
+                });
+            }
+        } else {
+            for (std::size_t head = 0; head < order.size(); head++) {
+                const int x = order[head];
+                adj.for_each_neighbour(x, [&](const int y, int) {
+                    if (dist[y] == -1) {
+                        dist[y] = dist[x] + 1;
+                        order.push_back(y);
+                    }
+                });
+            }
+        }
+    }
+
+    /// Writes the labels of the last search into column i of an n × k table (which is all -1 beforehand)
+    void store_column(const SearchBuffers &buffers, std::vector<int> &table, const int k, const int i) {
+        for (const int v : buffers.order) table[static_cast<std::size_t>(v) * k + i] = buffers.dist[v];
+    }
+
+    template <typename Adjacency>
+    std::vector<int> highest_degree(const Adjacency &adj, const int k) {
+        std::vector<int> vertices(adj.size());
+        std::iota(vertices.begin(), vertices.end(), 0);
+        std::partial_sort(vertices.begin(), vertices.begin() + k, vertices.end(), [&](const int a, const int b) {
+            return adj.degree(a) != adj.degree(b) ? adj.degree(a) > adj.degree(b) : a < b;
+        });
+        vertices.resize(k);
+        return vertices;
+    }
+
+    std::vector<int> random_vertices(const int n, const int k, const unsigned int seed) {
+        std::vector<int> all(n);
+        std::iota(all.begin(), all.end(), 0);
+        std::mt19937 gen(seed != 0 ? seed
+                                   : static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+        std::vector<int> chosen;
+        chosen.reserve(k);
+        std::ranges::sample(all, std::back_inserter(chosen), k, gen);
+        return chosen;
+    }
+
+    /// Fills one column per landmark of table with searches over adj, in parallel
+    template <typename Weight, typename Adjacency>
+    void fill_columns(const Adjacency &adj, const std::vector<int> &landmarks, std::vector<int> &table,
+                      const unsigned int threads, CancelToken *token) {
+        const int k = static_cast<int>(landmarks.size());
+        for_each_task<SearchBuffers>(landmarks.size(), threads, [&](SearchBuffers& buffers, const std::size_t i) {
+            check_cancelled(token);
+            shortest_distances<Weight>(adj, landmarks[i], buffers);
+            store_column(buffers, table, k, static_cast<int>(i));
+            if (token != nullptr) token->advance();
+        });
+    }
+}
+
+bool parse_landmark_strategy(const std::string_view name, LandmarkStrategy &strategy) {
+    if (name == "degree") strategy = LandmarkStrategy::Degree;
+    else if (name == "random") strategy = LandmarkStrategy::Random;
+    else if (name == "farthest") strategy = LandmarkStrategy::Farthest;
+    else return false;
+    return true;
+}
+
+const char* landmark_strategy_name(const LandmarkStrategy strategy) {
+    switch (strategy) {
+        case LandmarkStrategy::Degree: return "degree";
+        case LandmarkStrategy::Random: return "random";
+        case LandmarkStrategy::Farthest: return "farthest";
+    }
+    return "unknown";
+}
+
+std::size_t estimate_landmark_footprint(const int n, const int k, const bool directed) {
+    return static_cast<std::size_t>(n) * static_cast<std::size_t>(k) * sizeof(int) * (directed ? 2 : 1);
+}
+
+template <typename Weight, typename Direction>
+std::shared_ptr<const LandmarkTable> build_landmarks(const Graph &graph, int k, const LandmarkStrategy strategy,
+                                                     const unsigned int threads, const unsigned int seed,
+                                                     CancelToken *token) {
+    if (k < 1) throw std::invalid_argument("number of landmarks must be positive");
+    k = std::min(k, graph.n);
+
+    auto table = std::make_shared<LandmarkTable>();
+    table->n = graph.n;
+    table->k = k;
+    table->strategy = strategy;
+    table->from.assign(static_cast<std::size_t>(graph.n) * k, -1);
+    if (Direction::value) table->to.assign(table->from.size(), -1);
+    if (token != nullptr) token->set_total(static_cast<std::size_t>(k) * (Direction::value ? 2 : 1));
+
+    std::visit([&](const auto& adj) {
+        switch (strategy) {
+            case LandmarkStrategy::Degree:
+                table->landmarks = highest_degree(adj, k);
+                fill_columns<Weight>(adj, table->landmarks, table->from, threads, token);
+                break;
+            case LandmarkStrategy::Random:
+                table->landmarks = random_vertices(graph.n, k, seed);
+                fill_columns<Weight>(adj, table->landmarks, table->from, threads, token);
+                break;
+            case LandmarkStrategy::Farthest: {
+                // closest[v]: distance from the nearest landmark so far; unreached vertices count as farthest
+                constexpr int unreached = std::numeric_limits<int>::max();
+                std::vector<int> closest(graph.n, unreached);
+                SearchBuffers buffers;
+                int next = highest_degree(adj, 1).front();
+                for (int i = 0; i < k; i++) {
+                    check_cancelled(token);
+                    table->landmarks.push_back(next);
+                    shortest_distances<Weight>(adj, next, buffers);
+                    store_column(buffers, table->from, k, i);
+                    for (const int v : buffers.order) closest[v] = std::min(closest[v], buffers.dist[v]);
+                    closest[next] = -1; // never chosen twice
+                    next = static_cast<int>(std::ranges::max_element(closest) - closest.begin());
+                    if (token != nullptr) token->advance();
+                }
+                break;
+            }
+        }
+    }, graph.adj_list);
+
+    if constexpr (Direction::value) {
+        const auto reverse = build_reverse_adjacency(graph);
+        std::visit([&](const auto& in_adj) {
+            fill_columns<Weight>(in_adj, table->landmarks, table->to, threads, token);
+        }, reverse->adj);
+    }
+
+    table->tracked = TrackedBytes(MemoryCategory::Index, estimate_landmark_footprint(graph.n, k, Direction::value));
+    return table;
+}
+
+DistanceBounds landmark_bounds(const LandmarkTable &table, const int u, const int v) {
+    DistanceBounds bounds;
+    const int* from_u = table.from_row(u);
+    const int* from_v = table.from_row(v);
+    const int* to_u = table.to_row(u);
+    const int* to_v = table.to_row(v);
+
+    for (int i = 0; i < table.k; i++) {
+        if (from_u[i] != -1) {
+            if (from_v[i] == -1) bounds.unreachable = true; // l reaches u but not v
+            else bounds.lower = std::max(bounds.lower, from_v[i] - from_u[i]);
+        }
+        if (to_v[i] != -1) {
+            if (to_u[i] == -1) bounds.unreachable = true; // v reaches l but u does not
+            else bounds.lower = std::max(bounds.lower, to_u[i] - to_v[i]);
+        }
+        if (to_u[i] != -1 && from_v[i] != -1 && (bounds.upper == -1 || to_u[i] + from_v[i] < bounds.upper)) {
+            bounds.upper = to_u[i] + from_v[i];
+        }
+    }
+    if (u == v) bounds = {0, 0, false};
+    return bounds;
+}
+
+template <typename Weight>
+PointDistance alt_distance(const Graph &graph, const LandmarkTable &table, const int u, const int v,
+                           SearchWorkspace &workspace, const CancelToken *token) {
+    for (const int vertex : {u, v}) {
+        if (vertex < 0 || vertex >= graph.n) throw std::out_of_range("vertex " + std::to_string(vertex) + " is out of range");
+    }
+    workspace.prepare(graph.n);
+    if (u == v) return {0, 0};
+
+    const int source = internal_vertex(graph, u);
+    const int target = internal_vertex(graph, v);
+    if (landmark_bounds(table, source, target).unreachable) return {-1, 0};
+
+    // forward holds the distance from the source, backward caches the potential (lower bound towards target)
+    std::vector<int>& dist = workspace.forward;
+    std::vector<int>& potential = workspace.backward;
+    const int* from_target = table.from_row(target);
+    const int* to_target = table.to_row(target);
+    const auto lower_bound = [&](const int x) {
+        const int* from_x = table.from_row(x);
+        const int* to_x = table.to_row(x);
+        int bound = 0;
+        for (int i = 0; i < table.k; i++) {
+            if (from_x[i] != -1 && from_target[i] != -1) bound = std::max(bound, from_target[i] - from_x[i]);
+            if (to_x[i] != -1 && to_target[i] != -1) bound = std::max(bound, to_x[i] - to_target[i]);
+        }
+        return bound;
+    };
+
+    std::vector<HeapEntry>& heap = workspace.forward_heap;
+    heap.clear();
+    const int distance = std::visit([&](const auto& adj) {
+        workspace.label(dist, source, 0);
+        workspace.label(potential, source, lower_bound(source));
+        heap.emplace_back(potential[source], source);
+
+        while (!heap.empty()) {
+            std::ranges::pop_heap(heap, std::greater<>{});
+            const auto [key, x] = heap.back();
+            heap.pop_back();
+            if (key != dist[x] + potential[x]) continue; // stale entry
+            if (x == target) return dist[x];
+            check_cancelled(token);
+
+            adj.for_each_neighbour(x, [&](const int y, const int weight) {
+                const int candidate = dist[x] + (Weight::value ? weight : 1);
+                if (dist[y] != -1 && candidate >= dist[y]) return;
+                workspace.label(dist, y, candidate);
+                if (potential[y] == -1) workspace.label(potential, y, lower_bound(y));
+                heap.emplace_back(candidate + potential[y], y);
+                std::ranges::push_heap(heap, std::greater<>{});
+            });
+        }
+        return -1;
+    }, graph.adj_list);
+
+    return {distance, workspace.touched_count()};
+}
+
+template std::shared_ptr<const LandmarkTable> build_landmarks<Unweighted, Undirected>(
+    const Graph &, int, LandmarkStrategy, unsigned int, unsigned int, CancelToken *);
+template std::shared_ptr<const LandmarkTable> build_landmarks<Unweighted, Directed>(
+    const Graph &, int, LandmarkStrategy, unsigned int, unsigned int, CancelToken *);
+template std::shared_ptr<const LandmarkTable> build_landmarks<Weighted, Undirected>(
+    const Graph &, int, LandmarkStrategy, unsigned int, unsigned int, CancelToken *);
+template std::shared_ptr<const LandmarkTable> build_landmarks<Weighted, Directed>(
+    const Graph &, int, LandmarkStrategy, unsigned int, unsigned int, CancelToken *);
+
+template PointDistance alt_distance<Unweighted>(const Graph &, const LandmarkTable &, int, int, SearchWorkspace &,
+                                                const CancelToken *);
+template PointDistance alt_distance<Weighted>(const Graph &, const LandmarkTable &, int, int, SearchWorkspace &,
+                                              const CancelToken *);
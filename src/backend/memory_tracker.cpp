@@ -0,0 +1,234 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/memory_tracker.h"
+#include "../../include/backend/graph_storage.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi")
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr auto category_count = static_cast<std::size_t>(MemoryCategory::Count);
+
+    std::array<std::atomic<std::size_t>, category_count> current_bytes{};
+    std::array<std::atomic<std::size_t>, category_count> peak_bytes{};
+    std::atomic<std::size_t> total_current{0};
+    std::atomic<std::size_t> total_peak{0};
+    std::atomic<std::size_t> budget_bytes{0};
+
+    void update_peak(std::atomic<std::size_t>& peak, const std::size_t value) {
+        std::size_t prev = peak.load(std::memory_order_relaxed);
+        while (value > prev && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+    }
+
+    std::size_t saturating_add(const std::size_t a, const std::size_t b) {
+        return a > std::numeric_limits<std::size_t>::max() - b ? std::numeric_limits<std::size_t>::max() : a + b;
+    }
+
+    std::size_t saturating_mul(const std::size_t a, const std::size_t b) {
+        if (a != 0 && b > std::numeric_limits<std::size_t>::max() / a) return std::numeric_limits<std::size_t>::max();
+        return a * b;
+    }
+}
+
+void track_allocation(const MemoryCategory category, const std::size_t bytes) {
+    const auto idx = static_cast<std::size_t>(category);
+    const std::size_t now = current_bytes[idx].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    update_peak(peak_bytes[idx], now);
+    update_peak(total_peak, total_current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void track_deallocation(const MemoryCategory category, const std::size_t bytes) {
+    const auto idx = static_cast<std::size_t>(category);
+    current_bytes[idx].fetch_sub(bytes, std::memory_order_relaxed);
+    total_current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryUsage get_memory_usage(const MemoryCategory category) {
+    const auto idx = static_cast<std::size_t>(category);
+    return {current_bytes[idx].load(std::memory_order_relaxed), peak_bytes[idx].load(std::memory_order_relaxed)};
+}
+
+MemoryUsage get_total_memory_usage() {
+    return {total_current.load(std::memory_order_relaxed), total_peak.load(std::memory_order_relaxed)};
+}
+
+const char* memory_category_name(const MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::AdjacencyMatrix: return "Adjacency matrix";
+        case MemoryCategory::AdjacencyList: return "Adjacency list";
+        case MemoryCategory::DistanceMatrix: return "Distance matrix";
+        case MemoryCategory::Cache: return "Caches";
+        case MemoryCategory::Index: return "Query indexes";
+        default: return "Unknown";
+    }
+}
+
+MemoryUsage get_process_rss() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return {counters.WorkingSetSize, counters.PeakWorkingSetSize};
+    }
+    return {0, 0};
+#else
+    MemoryUsage usage{0, 0};
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        std::size_t kb = 0;
+        if (std::sscanf(line.c_str(), "VmRSS: %zu kB", &kb) == 1) usage.current = kb * 1024;
+        else if (std::sscanf(line.c_str(), "VmHWM: %zu kB", &kb) == 1) usage.peak = kb * 1024;
+    }
+
+    if (usage.peak == 0) {
+        rusage ru{};
+        if (getrusage(RUSAGE_SELF, &ru) == 0) {
+#ifdef __APPLE__
+            usage.peak = static_cast<std::size_t>(ru.ru_maxrss);
+#else
+            usage.peak = static_cast<std::size_t>(ru.ru_maxrss) * 1024;
+#endif
+        }
+    }
+    return usage;
+#endif
+}
+
+std::size_t get_physical_memory() {
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    return GlobalMemoryStatusEx(&status) ? static_cast<std::size_t>(status.ullTotalPhys) : 0;
+#else
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0) return 0;
+    return saturating_mul(static_cast<std::size_t>(pages), static_cast<std::size_t>(page_size));
+#endif
+}
+
+void set_memory_budget(const std::size_t bytes) {
+    budget_bytes.store(bytes, std::memory_order_relaxed);
+}
+
+std::size_t get_memory_budget() {
+    if (const std::size_t bytes = budget_bytes.load(std::memory_order_relaxed); bytes != 0) return bytes;
+    return get_physical_memory() / 10 * 8;
+}
+
+bool memory_budget_allows(const std::size_t bytes, const std::size_t releasing) {
+    const std::size_t budget = get_memory_budget();
+    if (budget == 0) return true;
+
+    const std::size_t current = total_current.load(std::memory_order_relaxed);
+    const std::size_t remaining = current > releasing ? current - releasing : 0;
+    return saturating_add(remaining, bytes) <= budget;
+}
+
+std::size_t get_free_memory_budget() {
+    const std::size_t budget = get_memory_budget();
+    if (budget == 0) return std::numeric_limits<std::size_t>::max();
+
+    const std::size_t current = total_current.load(std::memory_order_relaxed);
+    return budget > current ? budget - current : 0;
+}
+
+std::size_t estimate_graph_footprint(const int n, const double edgeProb, const double loopProb, const bool weighted) {
+    if (n <= 0) return 0;
+    const auto count = static_cast<std::size_t>(n);
+
+    // create_graph compares against whole percents, so quantize the same way
+    const double edge_p = static_cast<int>(edgeProb * 100) / 100.0;
+    const double loop_p = static_cast<int>(loopProb * 100) / 100.0;
+
+    // Both directed and undirected graphs store ~p*n*(n-1) off-diagonal entries plus loops
+    const double expected_entries = edge_p * static_cast<double>(count) * static_cast<double>(count - 1)
+                                    + loop_p * static_cast<double>(count);
+
+    const std::size_t matrix = saturating_add(saturating_mul(saturating_mul(count, count), sizeof(int)),
+                                              saturating_mul(count, sizeof(int*)));
+    const double list_entries_bytes = std::ceil(expected_entries) * static_cast<double>(adjacency_entry_bytes(n, weighted));
+    const std::size_t list_entries = list_entries_bytes >= static_cast<double>(std::numeric_limits<std::size_t>::max())
+                                         ? std::numeric_limits<std::size_t>::max()
+                                         : static_cast<std::size_t>(list_entries_bytes);
+    const std::size_t list = saturating_add(saturating_mul(count + 1, sizeof(std::size_t)), list_entries);
+
+    return saturating_add(matrix, list);
+}
+
+std::size_t estimate_distance_matrix_footprint(const int n) {
+    if (n <= 0) return 0;
+    const auto count = static_cast<std::size_t>(n);
+    return saturating_add(saturating_mul(saturating_mul(count, count), sizeof(int)),
+                          saturating_mul(count, sizeof(std::vector<int>)));
+}
+
+std::string format_bytes(const std::size_t bytes) {
+    static constexpr const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    auto value = static_cast<double>(bytes);
+    std::size_t unit = 0;
+    while (value >= 1024.0 && unit + 1 < std::size(units)) {
+        value /= 1024.0;
+        unit++;
+    }
+
+    char buffer[32];
+    if (unit == 0) std::snprintf(buffer, sizeof(buffer), "%zu B", bytes);
+    else std::snprintf(buffer, sizeof(buffer), "%.1f %s", value, units[unit]);
+    return buffer;
+}
+
+std::size_t parse_byte_size(const std::string& str) {
+    std::size_t pos = 0;
+    const double value = std::stod(str, &pos);
+    if (!std::isfinite(value)) throw std::invalid_argument("invalid size: " + str);
+    if (value < 0) throw std::invalid_argument("negative size: " + str);
+
+    // A unit letter, optionally followed by "B" or "iB", or a bare "B"; nothing else may follow
+    double multiplier = 1.0;
+    std::string suffix = str.substr(pos);
+    std::ranges::transform(suffix, suffix.begin(), [](const unsigned char c) { return std::toupper(c); });
+    if (!suffix.empty() && suffix != "B") {
+        switch (suffix[0]) {
+            case 'K': multiplier = 1024.0; break;
+            case 'M': multiplier = 1024.0 * 1024.0; break;
+            case 'G': multiplier = 1024.0 * 1024.0 * 1024.0; break;
+            case 'T': multiplier = 1024.0 * 1024.0 * 1024.0 * 1024.0; break;
+            default: throw std::invalid_argument("unknown size suffix: " + str);
+        }
+        if (const std::string rest = suffix.substr(1); !rest.empty() && rest != "B" && rest != "IB") {
+            throw std::invalid_argument("unknown size suffix: " + str);
+        }
+    }
+
+    // Converting a product beyond the range of std::size_t would be undefined
+    const double bytes = value * multiplier;
+    if (bytes >= std::ldexp(1.0, std::numeric_limits<std::size_t>::digits)) {
+        throw std::invalid_argument("size too large: " + str);
+    }
+    return static_cast<std::size_t>(bytes);
+}
@@ -0,0 +1,315 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/point_queries.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "../../include/backend/graph_gen.h"
+#include "../../include/backend/graph_policies.h"
+
+namespace {
+    constexpr int unreached = std::numeric_limits<int>::max();
+
+    using HeapEntry = std::pair<int, int>;
+
+    void push_entry(std::vector<HeapEntry>& heap, const int distance, const int v) {
+        heap.emplace_back(distance, v);
+        std::ranges::push_heap(heap, std::greater<>{});
+    }
+
+    HeapEntry pop_entry(std::vector<HeapEntry>& heap) {
+        std::ranges::pop_heap(heap, std::greater<>{});
+        const HeapEntry top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    /// Where the two searches of a bidirectional query joined
+    struct Meeting {
+        int distance = -1; ///< Length of the shortest connection, -1 if there is none
+        int from = -1;     ///< Vertex reached by the forward search...
+        int to = -1;       ///< ...with an edge to this vertex reached by the backward search
+    };
+
+    /// Level-synchronous bidirectional BFS
+    template <typename Adjacency>
+    Meeting bidirectional_bfs(const Adjacency& out_adj, const Adjacency& in_adj, const int source, const int target,
+                              SearchWorkspace& ws, const CancelToken* token) {
+        ws.label(ws.forward, source, 0);
+        ws.label(ws.backward, target, 0);
+        ws.forward_parent[source] = -1;
+        ws.backward_parent[target] = -1;
+        ws.frontier.assign(1, source);
+        ws.other_frontier.assign(1, target);
+
+        int forward_depth = 0;
+        int backward_depth = 0;
+        std::vector<int>* forward_frontier = &ws.frontier;
+        std::vector<int>* backward_frontier = &ws.other_frontier;
+
+        while (!forward_frontier->empty() && !backward_frontier->empty()) {
+            const bool forward_side = forward_frontier->size() <= backward_frontier->size();
+            const Adjacency& adj = forward_side ? out_adj : in_adj;
+            std::vector<int>& mine = forward_side ? ws.forward : ws.backward;
+            std::vector<int>& parent = forward_side ? ws.forward_parent : ws.backward_parent;
+            const std::vector<int>& other = forward_side ? ws.backward : ws.forward;
+            std::vector<int>*& frontier = forward_side ? forward_frontier : backward_frontier;
+            const int depth = forward_side ? forward_depth : backward_depth;
+
+            // Every meeting found in this level is a candidate; the shortest is among them
+            Meeting best;
+            ws.next.clear();
+            for (const int x : *frontier) {
+                check_cancelled(token);
+                adj.for_each_neighbour(x, [&](const int y, int) {
+                    if (other[y] != -1 && (best.distance == -1 || depth + 1 + other[y] < best.distance)) {
+                        best = forward_side ? Meeting{depth + 1 + other[y], x, y} : Meeting{depth + 1 + other[y], y, x};
+                    }
+                    if (mine[y] == -1) {
+                        ws.label(mine, y, depth + 1);
+                        parent[y] = x;
+                        ws.next.push_back(y);
+                    }
+                });
+            }
+            if (best.distance != -1) return best;
+
+            frontier->swap(ws.next);
+            (forward_side ? forward_depth : backward_depth)++;
+        }
+        return {};
+    }
+
+    /// Bidirectional Dijkstra
+    template <typename Adjacency>
+    Meeting bidirectional_dijkstra(const Adjacency& out_adj, const Adjacency& in_adj, const int source,
+                                   const int target, SearchWorkspace& ws, const CancelToken* token) {
+        ws.forward_heap.clear();
+        ws.backward_heap.clear();
+        ws.label(ws.forward, source, 0);
+        ws.label(ws.backward, target, 0);
+        ws.forward_parent[source] = -1;
+        ws.backward_parent[target] = -1;
+        push_entry(ws.forward_heap, 0, source);
+        push_entry(ws.backward_heap, 0, target);
+
+        Meeting best;
+        best.distance = unreached;
+        while (!ws.forward_heap.empty() && !ws.backward_heap.empty()) {
+            // No unsettled vertex can lie on a connection shorter than best any more
+            if (static_cast<long long>(ws.forward_heap.front().first) + ws.backward_heap.front().first >= best.distance) {
+                break;
+            }
+
+            const bool forward_side = ws.forward_heap.size() <= ws.backward_heap.size();
+            const Adjacency& adj = forward_side ? out_adj : in_adj;
+            std::vector<int>& mine = forward_side ? ws.forward : ws.backward;
+            std::vector<int>& parent = forward_side ? ws.forward_parent : ws.backward_parent;
+            const std::vector<int>& other = forward_side ? ws.backward : ws.forward;
+            std::vector<HeapEntry>& heap = forward_side ? ws.forward_heap : ws.backward_heap;
+
+            const auto [distance, x] = pop_entry(heap);
+            if (distance > mine[x]) continue; // stale entry
+            check_cancelled(token);
+
+            adj.for_each_neighbour(x, [&](const int y, const int weight) {
+                const int candidate = distance + weight;
+                if (mine[y] == -1 || candidate < mine[y]) {
+                    ws.label(mine, y, candidate);
+                    parent[y] = x;
+                    push_entry(heap, candidate, y);
+                }
+                if (other[y] != -1 && candidate + other[y] < best.distance) {
+                    best = forward_side ? Meeting{candidate + other[y], x, y} : Meeting{candidate + other[y], y, x};
+                }
+            });
+        }
+        return best.distance == unreached ? Meeting{} : best;
+    }
+
+    template <typename Weight>
+    Meeting bidirectional_search(const Graph &graph, const int source, const int target,
+                                 const ReverseAdjacency *reverse, SearchWorkspace &workspace,
+                                 const CancelToken *token) {
+        return std::visit([&](const auto& adj) {
+            using Adjacency = std::decay_t<decltype(adj)>;
+            const Adjacency& in_adj = reverse != nullptr ? std::get<Adjacency>(reverse->adj) : adj;
+            if constexpr (Weight::value && Adjacency::has_weights) {
+                return bidirectional_dijkstra(adj, in_adj, source, target, workspace, token);
+            } else {
+                return bidirectional_bfs(adj, in_adj, source, target, workspace, token);
+            }
+        }, graph.adj_list);
+    }
+
+    void check_vertices(const Graph &graph, const int u, const int v) {
+        for (const int vertex : {u, v}) {
+            if (vertex < 0 || vertex >= graph.n) {
+                throw std::out_of_range("vertex " + std::to_string(vertex) + " is out of range");
+            }
+        }
+    }
+}
+
+std::shared_ptr<const ReverseAdjacency> build_reverse_adjacency(const Graph &graph) {
+    auto reverse = std::make_shared<ReverseAdjacency>();
+    reverse->adj = std::visit([&](const auto& adj) -> AdjacencyStorage {
+        using Adjacency = std::decay_t<decltype(adj)>;
+        Adjacency incoming;
+        const int n = adj.size();
+
+        // Counting sort of all edges by target
+        incoming.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (const auto target : adj.targets) incoming.offsets[target + 1]++;
+        for (int v = 0; v < n; v++) incoming.offsets[v + 1] += incoming.offsets[v];
+
+        std::vector<std::size_t> fill(incoming.offsets.begin(), incoming.offsets.end() - 1);
+        incoming.targets.resize(adj.edge_count());
+        if constexpr (Adjacency::has_weights) incoming.weights.resize(adj.edge_count());
+        for (int x = 0; x < n; x++) {
+            for (std::size_t edge = adj.offsets[x]; edge < adj.offsets[x + 1]; edge++) {
+                const std::size_t slot = fill[adj.targets[edge]]++;
+                incoming.targets[slot] = static_cast<typename Adjacency::vertex_type>(x);
+                if constexpr (Adjacency::has_weights) incoming.weights[slot] = adj.weights[edge];
+            }
+        }
+        return incoming;
+    }, graph.adj_list);
+
+    const std::size_t bytes = std::visit([](const auto& adj) { return adj.bytes(); }, reverse->adj);
+    reverse->tracked = TrackedBytes(MemoryCategory::AdjacencyList, bytes);
+    return reverse;
+}
+
+void SearchWorkspace::prepare(const int n) {
+    const auto size = static_cast<std::size_t>(n);
+    if (forward.size() != size) {
+        forward.assign(size, -1);
+        backward.assign(size, -1);
+        forward_parent.assign(size, -1);
+        backward_parent.assign(size, -1);
+        touched.clear();
+        return;
+    }
+    for (const int v : touched) {
+        forward[v] = -1;
+        backward[v] = -1;
+    }
+    touched.clear();
+}
+
+template <typename Weight>
+PointDistance point_distance(const Graph &graph, const int u, const int v, const ReverseAdjacency *reverse,
+                             SearchWorkspace &workspace, const CancelToken *token) {
+    check_vertices(graph, u, v);
+    workspace.prepare(graph.n);
+    if (u == v) return {0, 0};
+
+    const Meeting meeting = bidirectional_search<Weight>(graph, internal_vertex(graph, u), internal_vertex(graph, v),
+                                                         reverse, workspace, token);
+    return {meeting.distance, workspace.touched_count()};
+}
+
+template <typename Weight>
+PointPath point_path(const Graph &graph, const int u, const int v, const ReverseAdjacency *reverse,
+                     SearchWorkspace &workspace, const CancelToken *token) {
+    check_vertices(graph, u, v);
+    workspace.prepare(graph.n);
+    if (u == v) return {0, {u}, 0};
+
+    const Meeting meeting = bidirectional_search<Weight>(graph, internal_vertex(graph, u), internal_vertex(graph, v),
+                                                         reverse, workspace, token);
+    PointPath result{meeting.distance, {}, workspace.touched_count()};
+    if (meeting.distance == -1) return result;
+
+    // Forward parents lead back to u, backward parents lead on to v
+    for (int x = meeting.from; x != -1; x = workspace.forward_parent[x]) {
+        result.vertices.push_back(original_vertex(graph, x));
+    }
+    std::ranges::reverse(result.vertices);
+    for (int x = meeting.to; x != -1; x = workspace.backward_parent[x]) {
+        result.vertices.push_back(original_vertex(graph, x));
+    }
+    return result;
+}
+
+template <typename Weight>
+Neighbourhood bounded_search(const Graph &graph, const int v, const int limit, SearchWorkspace &workspace,
+                             const CancelToken *token) {
+    if (v < 0 || v >= graph.n) throw std::out_of_range("vertex " + std::to_string(v) + " is out of range");
+    if (limit < 0) throw std::invalid_argument("distance limit must not be negative");
+
+    workspace.prepare(graph.n);
+    std::vector<int>& dist = workspace.forward;
+    const int source = internal_vertex(graph, v);
+
+    // Vertices in order of increasing distance, as stored ids
+    std::vector<int>& found = workspace.frontier;
+    found.clear();
+
+    std::visit([&](const auto& adj) {
+        using Adjacency = std::decay_t<decltype(adj)>;
+        workspace.label(dist, source, 0);
+
+        if constexpr (Weight::value && Adjacency::has_weights) {
+            std::vector<HeapEntry>& heap = workspace.forward_heap;
+            heap.clear();
+            push_entry(heap, 0, source);
+
+            while (!heap.empty()) {
+                const auto [distance, x] = pop_entry(heap);
+                if (distance > dist[x]) continue; // stale entry
+                check_cancelled(token);
+                found.push_back(x);
+
+                adj.for_each_neighbour(x, [&](const int y, const int weight) {
+                    const int candidate = distance + weight;
+                    if (candidate <= limit && (dist[y] == -1 || candidate < dist[y])) {
+                        workspace.label(dist, y, candidate);
+                        push_entry(heap, candidate, y);
+                    }
+                });
+            }
+        } else {
+            // found doubles as the BFS queue
+            found.push_back(source);
+            for (std::size_t head = 0; head < found.size(); head++) {
+                const int x = found[head];
+                if (dist[x] == limit) continue;
+                check_cancelled(token);
+
+                adj.for_each_neighbour(x, [&](const int y, int) {
+                    if (dist[y] == -1) {
+                        workspace.label(dist, y, dist[x] + 1);
+                        found.push_back(y);
+                    }
+                });
+            }
+        }
+    }, graph.adj_list);
+
+    Neighbourhood hood;
+    hood.vertices.reserve(found.size());
+    hood.distances.reserve(found.size());
+    for (const int x : found) {
+        hood.vertices.push_back(original_vertex(graph, x));
+        hood.distances.push_back(dist[x]);
+    }
+    return hood;
+}
+
+template PointDistance point_distance<Weighted>(const Graph&, int, int, const ReverseAdjacency*, SearchWorkspace&,
+                                                const CancelToken*);
+template PointDistance point_distance<Unweighted>(const Graph&, int, int, const ReverseAdjacency*, SearchWorkspace&,
+                                                  const CancelToken*);
+
+template PointPath point_path<Weighted>(const Graph&, int, int, const ReverseAdjacency*, SearchWorkspace&,
+                                       const CancelToken*);
+template PointPath point_path<Unweighted>(const Graph&, int, int, const ReverseAdjacency*, SearchWorkspace&,
+                                         const CancelToken*);
+template Neighbourhood bounded_search<Weighted>(const Graph&, int, int, SearchWorkspace&, const CancelToken*);
+template Neighbourhood bounded_search<Unweighted>(const Graph&, int, int, SearchWorkspace&, const CancelToken*);
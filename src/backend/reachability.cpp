@@ -0,0 +1,117 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/reachability.h"
+
+#include <bit>
+#include <limits>
+
+#include "../../include/backend/graph_gen.h"
+
+std::size_t estimate_reachability_footprint(const int vertices, const int components) {
+    const auto c = static_cast<std::size_t>(components);
+    const std::size_t words = (c + 63) / 64;
+    if (words != 0 && c > std::numeric_limits<std::size_t>::max() / 8 / words) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return c * words * sizeof(std::uint64_t) + (static_cast<std::size_t>(vertices) + c) * sizeof(int);
+}
+
+std::shared_ptr<const ReachabilityIndex> build_reachability_index(const Graph &graph, const ComponentInfo &strong,
+                                                                 CancelToken *token) {
+    auto index = std::make_shared<ReachabilityIndex>();
+    const int count = strong.count;
+    index->count = count;
+    if (token != nullptr) token->set_total(count);
+
+    std::visit([&](const auto& adj) {
+        // Kahn's algorithm on the condensation; edges inside a component are ignored
+        std::vector<int> in_degree(count, 0);
+        std::size_t cross_edges = 0;
+        for (int v = 0; v < adj.size(); v++) {
+            for (const int w : adj.neighbours(v)) {
+                if (strong.component_of[w] != strong.component_of[v]) {
+                    in_degree[strong.component_of[w]]++;
+                    cross_edges++;
+                }
+            }
+        }
+
+        std::vector<int> order; // topological order of the original component ids
+        order.reserve(count);
+        for (int c = 0; c < count; c++) {
+            if (in_degree[c] == 0) order.push_back(c);
+        }
+        for (std::size_t head = 0; head < order.size(); head++) {
+            const int c = order[head];
+            for (const int v : strong.members[c]) {
+                for (const int w : adj.neighbours(v)) {
+                    const int d = strong.component_of[w];
+                    if (d != c && --in_degree[d] == 0) order.push_back(d);
+                }
+            }
+        }
+
+        std::vector<int> position(count);
+        for (int i = 0; i < count; i++) position[order[i]] = i;
+        index->component_of.resize(strong.component_of.size());
+        for (std::size_t v = 0; v < strong.component_of.size(); v++) {
+            index->component_of[v] = position[strong.component_of[v]];
+        }
+
+        // Sizes by topological id, as prefix sums so that a full word of reached components is one subtraction
+        std::vector<int> size_prefix(count + 1, 0);
+        for (int i = 0; i < count; i++) {
+            size_prefix[i + 1] = size_prefix[i] + static_cast<int>(strong.members[order[i]].size());
+        }
+
+        index->reach_count.resize(count);
+        if (cross_edges == 0) {
+            for (int i = 0; i < count; i++) index->reach_count[i] = size_prefix[i + 1] - size_prefix[i];
+            if (token != nullptr) token->advance(count);
+            return;
+        }
+
+        const std::size_t words = (static_cast<std::size_t>(count) + 63) / 64;
+        index->words = words;
+        index->closure.assign(static_cast<std::size_t>(count) * words, 0);
+
+        // Reverse topological order: every successor's row is final before it is ORed in
+        std::vector<int> merged(count, -1); // last row a component was ORed into, to skip parallel edges
+        for (int c = count - 1; c >= 0; c--) {
+            std::uint64_t* row = index->closure.data() + static_cast<std::size_t>(c) * words;
+            row[c / 64] |= std::uint64_t{1} << (c % 64);
+
+            for (const int v : strong.members[order[c]]) {
+                for (const int w : adj.neighbours(v)) {
+                    const int d = index->component_of[w];
+                    if (d == c || merged[d] == c) continue;
+                    merged[d] = c;
+                    const std::uint64_t* successor = index->closure.data() + static_cast<std::size_t>(d) * words;
+                    for (std::size_t word = d / 64; word < words; word++) row[word] |= successor[word];
+                }
+            }
+
+            int reached = 0;
+            for (std::size_t word = c / 64; word < words; word++) {
+                const std::size_t first = word * 64;
+                if (row[word] == ~std::uint64_t{0}) {
+                    reached += size_prefix[first + 64] - size_prefix[first];
+                    continue;
+                }
+                for (std::uint64_t bits = row[word]; bits != 0; bits &= bits - 1) {
+                    const std::size_t d = first + std::countr_zero(bits);
+                    reached += size_prefix[d + 1] - size_prefix[d];
+                }
+            }
+            index->reach_count[c] = reached;
+
+            if (token != nullptr) token->advance();
+            if (c % 64 == 0) check_cancelled(token);
+        }
+    }, graph.adj_list);
+
+    index->tracked = TrackedBytes(MemoryCategory::Index,
+                                  index->closure.size() * sizeof(std::uint64_t)
+                                  + (index->component_of.size() + index->reach_count.size()) * sizeof(int));
+    return index;
+}
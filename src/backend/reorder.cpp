@@ -0,0 +1,176 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/reorder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    /**
+     * Appends vertices reachable from start in BFS order; neighbours of every
+     * vertex are visited in the order given by less.
+     */
+    template <typename Adjacency, typename Less>
+    void append_bfs(const Adjacency &adj, const int start, std::vector<char> &visited, std::vector<int> &order,
+                    Less less, std::vector<int> &scratch) {
+        std::size_t head = order.size();
+        order.push_back(start);
+        visited[start] = 1;
+
+        while (head < order.size()) {
+            const int curr_v = order[head++];
+            scratch.clear();
+            for (const int next_v : adj.neighbours(curr_v)) {
+                if (!visited[next_v]) {
+                    visited[next_v] = 1;
+                    scratch.push_back(next_v);
+                }
+            }
+            std::sort(scratch.begin(), scratch.end(), less);
+            order.insert(order.end(), scratch.begin(), scratch.end());
+        }
+    }
+
+    template <typename Adjacency>
+    std::vector<int> vertex_order(const Adjacency &adj, const VertexOrder order) {
+        const int n = adj.size();
+        std::vector<int> by_id(n);
+        std::iota(by_id.begin(), by_id.end(), 0);
+
+        const auto degree = [&adj](const int v) { return adj.degree(v); };
+        const auto by_degree = [&degree](const int a, const int b) {
+            return degree(a) != degree(b) ? degree(a) < degree(b) : a < b;
+        };
+
+        if (order == VertexOrder::Degree) {
+            std::stable_sort(by_id.begin(), by_id.end(), [&degree](const int a, const int b) {
+                return degree(a) > degree(b);
+            });
+            return by_id;
+        }
+
+        std::vector<int> result;
+        result.reserve(n);
+        std::vector<char> visited(n, 0);
+        std::vector<int> scratch;
+
+        if (order == VertexOrder::Bfs) {
+            for (const int v : by_id) {
+                if (!visited[v]) append_bfs(adj, v, visited, result, std::less<int>(), scratch);
+            }
+            return result;
+        }
+
+        // Cuthill–McKee starts every traversal from the lowest-degree unvisited vertex
+        std::vector<int> starts = by_id;
+        std::sort(starts.begin(), starts.end(), by_degree);
+        for (const int v : starts) {
+            if (!visited[v]) append_bfs(adj, v, visited, result, by_degree, scratch);
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+}
+
+bool parse_vertex_order(const std::string_view name, VertexOrder &order) {
+    if (name == "rcm") order = VertexOrder::Rcm;
+    else if (name == "degree") order = VertexOrder::Degree;
+    else if (name == "bfs") order = VertexOrder::Bfs;
+    else return false;
+    return true;
+}
+
+std::vector<int> compute_vertex_order(const Graph &graph, const VertexOrder order) {
+    return std::visit([order](const auto& adj) { return vertex_order(adj, order); }, graph.adj_list);
+}
+
+void apply_vertex_order(Graph &graph, const std::vector<int> &permutation) {
+    const int n = graph.n;
+    if (static_cast<int>(permutation.size()) != n) {
+        throw std::invalid_argument("permutation size does not match vertex count");
+    }
+
+    std::vector<int> new_id(n, -1);
+    for (int v = 0; v < n; v++) {
+        const int old_v = permutation[v];
+        if (old_v < 0 || old_v >= n || new_id[old_v] != -1) {
+            throw std::invalid_argument("not a permutation of graph vertices");
+        }
+        new_id[old_v] = v;
+    }
+
+    // Matrix: move whole rows by pointer, then permute columns inside every row
+    if (graph.adj_matrix != nullptr) {
+        std::vector<int*> rows(n);
+        for (int v = 0; v < n; v++) rows[v] = graph.adj_matrix[permutation[v]];
+        std::copy(rows.begin(), rows.end(), graph.adj_matrix);
+
+        std::vector<int> scratch(n);
+        for (int v = 0; v < n; v++) {
+            int* row = graph.adj_matrix[v];
+            for (int j = 0; j < n; j++) scratch[j] = row[permutation[j]];
+            std::copy(scratch.begin(), scratch.end(), row);
+        }
+    }
+
+    // Labels: compose with any earlier renumbering
+    std::vector<int> original_id(n);
+    bool identity = true;
+    for (int v = 0; v < n; v++) {
+        original_id[v] = original_vertex(graph, permutation[v]);
+        identity = identity && original_id[v] == v;
+    }
+
+    // Lists: neighbours stay sorted by user-facing id, so BFS discovers vertices in exactly
+    // the same order as before renumbering and weighted BFS distances do not change
+    track_deallocation(MemoryCategory::AdjacencyList, graph_list_bytes(graph));
+    std::visit([&](auto& adj) {
+        std::decay_t<decltype(adj)> lists;
+        lists.offsets.reserve(adj.offsets.size());
+        lists.targets.reserve(adj.targets.size());
+        lists.weights.reserve(adj.weights.size());
+
+        std::vector<std::pair<int, int>> row;
+        for (int v = 0; v < n; v++) {
+            row.clear();
+            adj.for_each_neighbour(permutation[v], [&row, &new_id](const int next_v, const int weight) {
+                row.emplace_back(new_id[next_v], weight);
+            });
+            std::sort(row.begin(), row.end(), [&original_id](const auto& a, const auto& b) {
+                return original_id[a.first] < original_id[b.first];
+            });
+            for (const auto& [next_v, weight] : row) lists.push(next_v, weight);
+            lists.end_row();
+        }
+        adj = std::move(lists);
+    }, graph.adj_list);
+    track_allocation(MemoryCategory::AdjacencyList, graph_list_bytes(graph));
+
+    if (identity) {
+        graph.original_id.clear();
+        graph.internal_id.clear();
+        return;
+    }
+
+    graph.internal_id.assign(n, 0);
+    for (int v = 0; v < n; v++) graph.internal_id[original_id[v]] = v;
+    graph.original_id = std::move(original_id);
+}
+
+int graph_bandwidth(const Graph &graph) {
+    return std::visit([](const auto& adj) {
+        int bandwidth = 0;
+        for (int v = 0; v < adj.size(); v++) {
+            for (const int next_v : adj.neighbours(v)) bandwidth = std::max(bandwidth, std::abs(next_v - v));
+        }
+        return bandwidth;
+    }, graph.adj_list);
+}
+
+Graph copy_in_original_order(const Graph &graph) {
+    Graph copy = copy_graph(graph);
+    if (!copy.internal_id.empty()) apply_vertex_order(copy, graph.internal_id);
+    return copy;
+}
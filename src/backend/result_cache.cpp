@@ -0,0 +1,150 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/result_cache.h"
+
+#include <algorithm>
+
+ResultCache::ResultCache(const std::size_t row_budget_bytes) : row_budget(row_budget_bytes) {}
+
+std::shared_ptr<const CachedRow> ResultCache::find_row(const std::uint64_t version, const int source) {
+    std::lock_guard lock(mutex);
+
+    if (const auto it = rows.find({version, source}); it != rows.end()) {
+        lru.splice(lru.begin(), lru, it->second.lru_position);
+        counters.row_hits++;
+        return it->second.row;
+    }
+
+    // An analysed graph already has every row in its distance matrix
+    if (const auto it = analyses.find(version); it != analyses.end()) {
+        const AnalysisResult& result = *it->second;
+        if (source >= 0 && source < static_cast<int>(result.eccentricities.size())) {
+            counters.row_hits++;
+            auto row = std::make_shared<CachedRow>();
+            const std::span<const int> distances = distance_row(result, source);
+            row->distances.assign(distances.begin(), distances.end());
+            return row;
+        }
+    }
+
+    counters.row_misses++;
+    return nullptr;
+}
+
+std::optional<int> ResultCache::find_distance(const std::uint64_t version, const int source, const int target) {
+    std::lock_guard lock(mutex);
+
+    if (const auto it = rows.find({version, source}); it != rows.end()) {
+        lru.splice(lru.begin(), lru, it->second.lru_position);
+        counters.row_hits++;
+        return it->second.row->distances[target];
+    }
+
+    if (const auto it = analyses.find(version); it != analyses.end()) {
+        counters.row_hits++;
+        return distance_row(*it->second, source)[target];
+    }
+
+    counters.row_misses++;
+    return std::nullopt;
+}
+
+void ResultCache::store_row(const std::uint64_t version, const int source, CachedRow row) {
+    std::lock_guard lock(mutex);
+    if (analyses.contains(version)) return;
+
+    const std::size_t bytes = row_size(row);
+    if (bytes > row_budget) return;
+
+    if (const auto it = rows.find({version, source}); it != rows.end()) erase_row(it);
+
+    lru.push_front({version, source});
+    rows.emplace(RowKey{version, source},
+                 RowEntry{std::make_shared<const CachedRow>(std::move(row)), lru.begin(),
+                          TrackedBytes(MemoryCategory::Cache, bytes)});
+    row_bytes += bytes;
+    evict_over_budget();
+}
+
+std::shared_ptr<const AnalysisResult> ResultCache::find_analysis(const std::uint64_t version) {
+    std::lock_guard lock(mutex);
+    if (const auto it = analyses.find(version); it != analyses.end()) {
+        counters.analysis_hits++;
+        return it->second;
+    }
+    counters.analysis_misses++;
+    return nullptr;
+}
+
+void ResultCache::store_analysis(const std::uint64_t version, std::shared_ptr<const AnalysisResult> result) {
+    std::lock_guard lock(mutex);
+    analyses[version] = std::move(result);
+
+    for (auto it = rows.begin(); it != rows.end();) {
+        if (it->first.version == version) {
+            const auto next = std::next(it);
+            erase_row(it);
+            it = next;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ResultCache::prune(const std::vector<std::uint64_t> &live_versions) {
+    std::lock_guard lock(mutex);
+    const auto is_live = [&live_versions](const std::uint64_t version) {
+        return std::ranges::find(live_versions, version) != live_versions.end();
+    };
+
+    for (auto it = rows.begin(); it != rows.end();) {
+        if (!is_live(it->first.version)) {
+            const auto next = std::next(it);
+            erase_row(it);
+            it = next;
+        } else {
+            ++it;
+        }
+    }
+    std::erase_if(analyses, [&is_live](const auto& entry) { return !is_live(entry.first); });
+}
+
+void ResultCache::clear() {
+    std::lock_guard lock(mutex);
+    rows.clear();
+    lru.clear();
+    analyses.clear();
+    row_bytes = 0;
+}
+
+void ResultCache::set_row_budget(const std::size_t bytes) {
+    std::lock_guard lock(mutex);
+    row_budget = bytes;
+    evict_over_budget();
+}
+
+ResultCache::Stats ResultCache::stats() const {
+    std::lock_guard lock(mutex);
+    Stats result = counters;
+    result.rows = rows.size();
+    result.row_bytes = row_bytes;
+    result.row_budget = row_budget;
+    result.analyses = analyses.size();
+    return result;
+}
+
+void ResultCache::erase_row(const std::unordered_map<RowKey, RowEntry, RowKeyHash>::iterator it) {
+    row_bytes -= it->second.tracked.size();
+    lru.erase(it->second.lru_position);
+    rows.erase(it);
+}
+
+void ResultCache::evict_over_budget() {
+    while (row_bytes > row_budget && !lru.empty()) {
+        erase_row(rows.find(lru.back()));
+    }
+}
+
+std::size_t ResultCache::row_size(const CachedRow &row) {
+    return sizeof(CachedRow) + row.distances.capacity() * sizeof(int) + row.order.capacity();
+}
@@ -0,0 +1,516 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/backend/snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+
+namespace {
+    constexpr char magic[4] = {'G', 'S', 'N', '1'};
+
+    constexpr std::uint32_t directed_flag = 1;
+    constexpr std::uint32_t weighted_flag = 2;
+    constexpr std::uint32_t reordered_flag = 4;       ///< original_id section present
+    constexpr std::uint32_t analysis_flag = 8;        ///< Analysis sections and distance matrix present
+    constexpr std::uint32_t shortest_paths_flag = 16; ///< AnalysisResult::shortest_paths
+
+    struct FileHeader {
+        char magic[4];
+        std::uint32_t flags;
+        std::int64_t n;
+        std::uint64_t edges;           ///< Adjacency entries
+        std::uint64_t fingerprint;     ///< graph_fingerprint
+        std::int32_t radius;
+        std::int32_t diameter;
+        std::int32_t components;
+        std::int32_t central;          ///< Number of central vertices
+        std::int32_t peripheral;       ///< Number of peripheral vertices
+        std::uint32_t reserved;
+        std::uint64_t body_bytes;      ///< Sections between header and matrix, each padded to 8 bytes
+        std::uint64_t body_checksum;
+        std::uint64_t matrix_offset;   ///< Byte offset of the distance matrix, 0 without analysis
+        std::uint64_t matrix_checksum; ///< Folded row by row
+    };
+    static_assert(sizeof(FileHeader) == 88);
+
+    /// Page-aligned, so the matrix can be mapped on its own as well
+    constexpr std::uint64_t matrix_alignment = 4096;
+
+    constexpr std::uint64_t padded(const std::uint64_t bytes) { return (bytes + 7) / 8 * 8; }
+
+    /**
+     * Folds data into a running checksum, 8 bytes at a time; a trailing
+     * partial word counts as zero-padded, like the section padding in the file.
+     */
+    std::uint64_t fold(std::uint64_t state, const void* data, const std::size_t bytes) {
+        const auto* bytes_in = static_cast<const unsigned char*>(data);
+        const auto step = [&state](const std::uint64_t word) {
+            state = std::rotl((state ^ word) * 0x9e3779b97f4a7c15ull, 31);
+        };
+        std::size_t i = 0;
+        for (; i + 8 <= bytes; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes_in + i, 8);
+            step(word);
+        }
+        if (i < bytes) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, bytes_in + i, bytes - i);
+            step(word);
+        }
+        return state;
+    }
+
+    constexpr std::uint64_t checksum_seed = 0x6a09e667f3bcc908ull;
+
+    /// Appends sections to the file, padded to 8 bytes, and folds them into the body checksum
+    class SectionWriter {
+    public:
+        explicit SectionWriter(std::ofstream &out) : file(out) {}
+
+        template <typename T>
+        void write(const std::span<const T> data) { write_bytes(data.data(), data.size_bytes()); }
+
+        /// Writes a section converting every element to Out, without a full copy
+        template <typename Out, typename In>
+        void write_as(const std::span<const In> data) {
+            if constexpr (std::is_same_v<Out, In>) {
+                write(data);
+            } else {
+                std::array<Out, 8192> buffer; // a multiple of 8 bytes, so chunks fold like one section
+                for (std::size_t first = 0; first < data.size(); first += buffer.size()) {
+                    const std::size_t count = std::min(buffer.size(), data.size() - first);
+                    std::transform(data.begin() + first, data.begin() + first + count, buffer.begin(),
+                                   [](const In value) { return static_cast<Out>(value); });
+                    write_chunk(buffer.data(), count * sizeof(Out));
+                }
+                pad(data.size() * sizeof(Out));
+            }
+        }
+
+        [[nodiscard]] std::uint64_t bytes() const { return written; }
+        [[nodiscard]] std::uint64_t checksum() const { return state; }
+
+    private:
+        std::ofstream &file;
+        std::uint64_t written = 0;
+        std::uint64_t state = checksum_seed;
+
+        void write_bytes(const void* data, const std::size_t bytes) {
+            write_chunk(data, bytes);
+            pad(bytes);
+        }
+
+        void write_chunk(const void* data, const std::size_t bytes) {
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            state = fold(state, data, bytes);
+            written += bytes;
+        }
+
+        void pad(const std::uint64_t bytes) {
+            constexpr char zeros[8] = {};
+            const std::uint64_t padding = padded(bytes) - bytes;
+            file.write(zeros, static_cast<std::streamsize>(padding)); // already folded with the last word
+            written += padding;
+        }
+    };
+
+    /// Reads sections back out of the body buffer, in the order they were written
+    class SectionReader {
+    public:
+        explicit SectionReader(const std::vector<std::uint64_t> &data) : body(data) {}
+
+        template <typename T>
+        std::span<const T> take(const std::uint64_t count) {
+            const std::uint64_t words = padded(count * sizeof(T)) / 8;
+            if (words > body.size() - position) throw std::runtime_error("snapshot sections are truncated");
+            const auto* data = reinterpret_cast<const T*>(body.data() + position);
+            position += words;
+            return {data, static_cast<std::size_t>(count)};
+        }
+
+    private:
+        const std::vector<std::uint64_t> &body;
+        std::size_t position = 0;
+    };
+
+    std::uint64_t expected_body_bytes(const FileHeader &header) {
+        const auto n = static_cast<std::uint64_t>(header.n);
+        std::uint64_t bytes = padded((n + 1) * sizeof(std::uint64_t)) + padded(header.edges * sizeof(std::uint32_t));
+        if (header.flags & weighted_flag) bytes += padded(header.edges);
+        if (header.flags & reordered_flag) bytes += padded(n * sizeof(int));
+        if (header.flags & analysis_flag) {
+            bytes += 2 * padded(n * sizeof(int)) + padded(static_cast<std::uint64_t>(header.components) * 3 * sizeof(int))
+                     + padded(static_cast<std::uint64_t>(header.central) * sizeof(int))
+                     + padded(static_cast<std::uint64_t>(header.peripheral) * sizeof(int));
+        }
+        return bytes;
+    }
+
+    /// Writes values converted to Out in chunks, without a full copy
+    template <typename Out, typename In>
+    void write_converted(std::ostream &out, const In* data, const std::size_t count) {
+        std::array<Out, 8192> buffer;
+        for (std::size_t first = 0; first < count; first += buffer.size()) {
+            const std::size_t chunk = std::min(buffer.size(), count - first);
+            std::transform(data + first, data + first + chunk, buffer.begin(),
+                           [](const In value) { return static_cast<Out>(value); });
+            out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(chunk * sizeof(Out)));
+        }
+    }
+
+    void write_zeros(std::ostream &out, const std::uint64_t bytes) {
+        constexpr char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(bytes));
+    }
+
+    std::runtime_error corrupt(const std::string &path, const std::string &what) {
+        return std::runtime_error("'" + path + "' is not a valid snapshot: " + what);
+    }
+
+    /// Rebuilds the graph's storage from the CSR sections, checking every value
+    Graph restore_graph(const FileHeader &header, SectionReader &sections, const int dense_matrix_limit,
+                        const std::string &path) {
+        const int n = static_cast<int>(header.n);
+        const bool weighted = header.flags & weighted_flag;
+        const auto offsets = sections.take<std::uint64_t>(static_cast<std::uint64_t>(n) + 1);
+        const auto targets = sections.take<std::uint32_t>(header.edges);
+        const auto weights = weighted ? sections.take<std::uint8_t>(header.edges) : std::span<const std::uint8_t>{};
+
+        if (offsets.front() != 0 || offsets.back() != header.edges || !std::ranges::is_sorted(offsets)) {
+            throw corrupt(path, "bad row offsets");
+        }
+        if (std::ranges::any_of(targets, [n](const std::uint32_t target) { return target >= static_cast<std::uint32_t>(n); })
+            || std::ranges::find(weights, 0) != weights.end()) {
+            throw corrupt(path, "bad adjacency entries");
+        }
+
+        Graph graph;
+        graph.n = n;
+        graph.adj_matrix = nullptr;
+        graph.adj_list = make_adjacency_storage(n, weighted);
+        std::visit([&](auto& adj) {
+            using Adjacency = std::decay_t<decltype(adj)>;
+            adj.offsets.assign(offsets.begin(), offsets.end());
+            adj.targets.resize(targets.size());
+            std::ranges::transform(targets, adj.targets.begin(), [](const std::uint32_t target) {
+                return static_cast<typename Adjacency::vertex_type>(target);
+            });
+            if constexpr (Adjacency::has_weights) adj.weights.assign(weights.begin(), weights.end());
+        }, graph.adj_list);
+
+        if (header.flags & reordered_flag) {
+            const auto original = sections.take<int>(static_cast<std::uint64_t>(n));
+            graph.internal_id.assign(n, -1);
+            for (int v = 0; v < n; v++) {
+                if (original[v] < 0 || original[v] >= n || graph.internal_id[original[v]] != -1) {
+                    throw corrupt(path, "vertex order is not a permutation");
+                }
+                graph.internal_id[original[v]] = v;
+            }
+            graph.original_id.assign(original.begin(), original.end());
+        }
+
+        if (n <= dense_matrix_limit) {
+            graph.adj_matrix = new int*[n];
+            for (int i = 0; i < n; i++) graph.adj_matrix[i] = new int[n]();
+            std::visit([&graph](const auto& adj) {
+                for (int i = 0; i < adj.size(); i++) {
+                    adj.for_each_neighbour(i, [&graph, i](const int j, const int weight) { graph.adj_matrix[i][j] = weight; });
+                }
+            }, graph.adj_list);
+        }
+
+        track_allocation(MemoryCategory::AdjacencyMatrix, graph_matrix_bytes(graph));
+        track_allocation(MemoryCategory::AdjacencyList, graph_list_bytes(graph));
+        return graph;
+    }
+
+    /// Restores everything but the matrix; vertex ids are user-facing, as analyse_graph leaves them
+    AnalysisResult restore_analysis(const FileHeader &header, SectionReader &sections, const std::string &path) {
+        const int n = static_cast<int>(header.n);
+        AnalysisResult result;
+        result.radius = header.radius;
+        result.diameter = header.diameter;
+        result.shortest_paths = header.flags & shortest_paths_flag;
+
+        const auto ecc = sections.take<int>(static_cast<std::uint64_t>(n));
+        const auto component_of = sections.take<int>(static_cast<std::uint64_t>(n));
+        const auto summary = sections.take<int>(static_cast<std::uint64_t>(header.components) * 3);
+        const auto central = sections.take<int>(static_cast<std::uint64_t>(header.central));
+        const auto peripheral = sections.take<int>(static_cast<std::uint64_t>(header.peripheral));
+
+        const auto is_vertex = [n](const int v) { return v >= 0 && v < n; };
+        if (!std::ranges::all_of(central, is_vertex) || !std::ranges::all_of(peripheral, is_vertex)
+            || !std::ranges::all_of(component_of, [&header](const int c) { return c >= 0 && c < header.components; })) {
+            throw corrupt(path, "bad analysis sections");
+        }
+
+        result.eccentricities.assign(ecc.begin(), ecc.end());
+        result.central.assign(central.begin(), central.end());
+        result.peripheral.assign(peripheral.begin(), peripheral.end());
+
+        result.components.count = header.components;
+        result.components.component_of.assign(component_of.begin(), component_of.end());
+        result.components.members.resize(header.components);
+        for (int v = 0; v < n; v++) result.components.members[component_of[v]].push_back(v);
+
+        result.component_summary.resize(header.components);
+        for (int c = 0; c < header.components; c++) {
+            result.component_summary[c] = {summary[3 * c], summary[3 * c + 1], summary[3 * c + 2]};
+        }
+        return result;
+    }
+}
+
+void save_snapshot(const std::string &path, const Graph &graph, const bool directed, const bool weighted,
+                   const AnalysisResult *analysis, CancelToken *token) {
+    const int n = graph.n;
+    const std::string temporary = path + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("cannot create '" + temporary + "'");
+
+    try {
+        FileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.flags = (directed ? directed_flag : 0) | (weighted ? weighted_flag : 0)
+                       | (graph.original_id.empty() ? 0 : reordered_flag);
+        header.n = n;
+        header.fingerprint = graph_fingerprint(graph);
+        if (analysis != nullptr) {
+            header.flags |= analysis_flag | (analysis->shortest_paths ? shortest_paths_flag : 0);
+            header.radius = analysis->radius;
+            header.diameter = analysis->diameter;
+            header.components = analysis->components.count;
+            header.central = static_cast<std::int32_t>(analysis->central.size());
+            header.peripheral = static_cast<std::int32_t>(analysis->peripheral.size());
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header)); // rewritten once the checksums are known
+
+        SectionWriter sections(file);
+        std::visit([&](const auto& adj) {
+            header.edges = adj.edge_count();
+            sections.template write_as<std::uint64_t>(std::span<const std::size_t>(adj.offsets));
+            sections.template write_as<std::uint32_t>(std::span(adj.targets));
+            if constexpr (std::decay_t<decltype(adj)>::has_weights) sections.write(std::span(adj.weights));
+        }, graph.adj_list);
+        if (!graph.original_id.empty()) sections.write(std::span(graph.original_id));
+
+        if (analysis != nullptr) {
+            std::vector<int> summary;
+            summary.reserve(analysis->component_summary.size() * 3);
+            for (const auto& [size, radius, diameter] : analysis->component_summary) {
+                summary.insert(summary.end(), {size, radius, diameter});
+            }
+            sections.write(std::span(analysis->eccentricities));
+            sections.write(std::span(analysis->components.component_of));
+            sections.write(std::span<const int>(summary));
+            sections.write(std::span(analysis->central));
+            sections.write(std::span(analysis->peripheral));
+        }
+        header.body_bytes = sections.bytes();
+        header.body_checksum = sections.checksum();
+
+        if (analysis != nullptr) {
+            header.matrix_offset = (sizeof(header) + header.body_bytes + matrix_alignment - 1) / matrix_alignment
+                                   * matrix_alignment;
+            const std::vector<char> gap(header.matrix_offset - sizeof(header) - header.body_bytes, 0);
+            file.write(gap.data(), static_cast<std::streamsize>(gap.size()));
+
+            if (token != nullptr) token->set_total(n);
+            std::uint64_t state = checksum_seed;
+            for (int v = 0; v < n; v++) {
+                check_cancelled(token);
+                const std::span<const int> row = distance_row(*analysis, v);
+                file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size_bytes()));
+                state = fold(state, row.data(), row.size_bytes());
+                if (token != nullptr) token->advance();
+            }
+            header.matrix_checksum = state;
+        }
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.close();
+        if (!file) throw std::runtime_error("cannot write '" + temporary + "'");
+
+        std::filesystem::rename(temporary, path);
+    } catch (...) {
+        if (file.is_open()) file.close();
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+        throw;
+    }
+}
+
+Snapshot load_snapshot(const std::string &path, const int dense_matrix_limit, const bool verify_matrix) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("cannot open '" + path + "'");
+
+    FileHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("'" + path + "' is not a snapshot file");
+    }
+
+    // Check the header against the file size before allocating anything it asks for
+    std::error_code error;
+    const std::uint64_t file_size = std::filesystem::file_size(path, error);
+    const auto n = static_cast<std::uint64_t>(header.n);
+    const bool has_analysis = header.flags & analysis_flag;
+    if (error || header.n <= 0 || header.n > INT32_MAX || header.edges > file_size || header.components < 0
+        || header.components > header.n || header.central < 0 || header.central > header.n || header.peripheral < 0
+        || header.peripheral > header.n || header.body_bytes != expected_body_bytes(header)) {
+        throw corrupt(path, "inconsistent header");
+    }
+    const std::uint64_t matrix_bytes = has_analysis ? n * n * sizeof(int) : 0;
+    if (has_analysis ? header.matrix_offset < sizeof(header) + header.body_bytes
+                           || file_size != header.matrix_offset + matrix_bytes
+                     : file_size != sizeof(header) + header.body_bytes) {
+        throw corrupt(path, "file size does not match its header");
+    }
+
+    std::vector<std::uint64_t> body(header.body_bytes / 8);
+    file.read(reinterpret_cast<char*>(body.data()), static_cast<std::streamsize>(header.body_bytes));
+    if (!file) throw std::runtime_error("cannot read '" + path + "'");
+    if (fold(checksum_seed, body.data(), header.body_bytes) != header.body_checksum) {
+        throw corrupt(path, "checksum mismatch");
+    }
+
+    Snapshot snapshot;
+    snapshot.directed = header.flags & directed_flag;
+    snapshot.weighted = header.flags & weighted_flag;
+    snapshot.fingerprint = header.fingerprint;
+
+    SectionReader sections(body);
+    snapshot.graph = make_shared_graph(restore_graph(header, sections, dense_matrix_limit, path));
+    if (graph_fingerprint(*snapshot.graph) != header.fingerprint) throw corrupt(path, "graph fingerprint mismatch");
+
+    if (has_analysis) {
+        AnalysisResult result = restore_analysis(header, sections, path);
+        auto matrix = DistanceMatrixFile::open_embedded(path, header.matrix_offset, static_cast<int>(header.n));
+        if (verify_matrix) {
+            std::uint64_t state = checksum_seed;
+            for (int v = 0; v < matrix->size(); v++) {
+                const std::span<const int> row = matrix->row(v);
+                state = fold(state, row.data(), row.size_bytes());
+            }
+            if (state != header.matrix_checksum) throw corrupt(path, "distance matrix checksum mismatch");
+        }
+        result.dist_file = std::move(matrix);
+        snapshot.analysis = std::make_shared<const AnalysisResult>(std::move(result));
+    }
+    return snapshot;
+}
+
+SnapshotGraphWriter::SnapshotGraphWriter(const std::string &path, const int n, const bool directed, const bool weighted)
+    : final_path(path), temporary(path + ".tmp"), weights_path(path + ".weights.tmp"), vertices(n), is_directed(directed),
+      is_weighted(weighted), fingerprint(n) {
+    file.open(temporary, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    if (!file) throw std::runtime_error("cannot create '" + temporary + "'");
+    if (weighted) {
+        weights_file.open(weights_path, std::ios::binary | std::ios::trunc);
+        if (!weights_file) throw std::runtime_error("cannot create '" + weights_path + "'");
+    }
+}
+
+SnapshotGraphWriter::~SnapshotGraphWriter() {
+    if (finished) return;
+    if (file.is_open()) file.close();
+    if (weights_file.is_open()) weights_file.close();
+    std::error_code ignored;
+    std::filesystem::remove(temporary, ignored);
+    std::filesystem::remove(weights_path, ignored);
+}
+
+void SnapshotGraphWriter::write(const RowBlock &block) {
+    if (block.first_row != next_row || block.rows() > vertices - next_row) {
+        throw std::invalid_argument("row block does not continue the snapshot");
+    }
+    if (is_weighted && block.weights.size() != block.targets.size()) {
+        throw std::invalid_argument("row block of a weighted graph carries no weights");
+    }
+
+    // Row offsets sit right after the header, targets after all n + 1 offsets
+    std::vector<std::uint64_t> offsets(block.offsets.begin(), block.offsets.end() - 1);
+    for (auto& offset : offsets) offset += entries;
+    file.seekp(static_cast<std::streamoff>(sizeof(FileHeader) + static_cast<std::uint64_t>(next_row) * 8));
+    file.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * 8));
+
+    const std::uint64_t targets_start = sizeof(FileHeader) + padded((static_cast<std::uint64_t>(vertices) + 1) * 8);
+    file.seekp(static_cast<std::streamoff>(targets_start + entries * sizeof(std::uint32_t)));
+    write_converted<std::uint32_t>(file, block.targets.data(), block.targets.size());
+    if (is_weighted) write_converted<std::uint8_t>(weights_file, block.weights.data(), block.weights.size());
+    if (!file || (is_weighted && !weights_file)) throw std::runtime_error("cannot write '" + temporary + "'");
+
+    for (int r = 0; r < block.rows(); r++) {
+        for (std::size_t i = block.offsets[r]; i < block.offsets[r + 1]; i++) {
+            fingerprint.add(block.first_row + r, block.targets[i], is_weighted ? block.weights[i] : 1);
+        }
+    }
+    next_row += block.rows();
+    entries += block.targets.size();
+}
+
+void SnapshotGraphWriter::finish() {
+    if (next_row != vertices) throw std::runtime_error("snapshot is missing rows " + std::to_string(next_row) + " and up");
+
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.flags = (is_directed ? directed_flag : 0) | (is_weighted ? weighted_flag : 0);
+    header.n = vertices;
+    header.edges = entries;
+    header.fingerprint = fingerprint.value();
+
+    file.seekp(static_cast<std::streamoff>(sizeof(FileHeader) + static_cast<std::uint64_t>(vertices) * 8));
+    file.write(reinterpret_cast<const char*>(&entries), sizeof(entries));
+
+    const std::uint64_t offsets_bytes = (static_cast<std::uint64_t>(vertices) + 1) * 8;
+    const std::uint64_t targets_bytes = entries * sizeof(std::uint32_t);
+    file.seekp(static_cast<std::streamoff>(sizeof(FileHeader) + offsets_bytes + targets_bytes));
+    write_zeros(file, padded(targets_bytes) - targets_bytes);
+    header.body_bytes = offsets_bytes + padded(targets_bytes);
+
+    if (is_weighted) {
+        weights_file.close();
+        if (!weights_file) throw std::runtime_error("cannot write '" + weights_path + "'");
+        if (entries > 0) {
+            // Streaming an empty buffer sets failbit, so only non-empty spools are copied
+            std::ifstream weights_in(weights_path, std::ios::binary);
+            file << weights_in.rdbuf();
+        }
+        write_zeros(file, padded(entries) - entries);
+        header.body_bytes += padded(entries);
+    }
+    file.flush();
+    if (!file) throw std::runtime_error("cannot write '" + temporary + "'");
+
+    // The sections were written out of order, so the checksum takes one more sequential read
+    std::vector<std::uint64_t> chunk(1 << 17);
+    std::uint64_t state = checksum_seed;
+    file.seekg(static_cast<std::streamoff>(sizeof(FileHeader)));
+    for (std::uint64_t done = 0; done < header.body_bytes;) {
+        const std::uint64_t bytes = std::min<std::uint64_t>(chunk.size() * 8, header.body_bytes - done);
+        file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(bytes));
+        if (!file) throw std::runtime_error("cannot read back '" + temporary + "'");
+        state = fold(state, chunk.data(), bytes);
+        done += bytes;
+    }
+    header.body_checksum = state;
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) throw std::runtime_error("cannot write '" + temporary + "'");
+
+    std::filesystem::rename(temporary, final_path);
+    std::error_code ignored;
+    std::filesystem::remove(weights_path, ignored);
+    finished = true;
+}
@@ -72,6 +72,7 @@ ConsoleConfig ConfigLoader::load_from_file(const std::string &filename) {
 
     CommandConfig command;
     bool isCommandSection = false;
+    bool isPerformanceSection = false;
 
     while (std::getline(file, line)) {
         line = trim(line);
@@ -86,6 +87,7 @@ ConsoleConfig ConfigLoader::load_from_file(const std::string &filename) {
 
             std::string section = line.substr(1, line.size() - 2);
             isCommandSection = (section == "command");
+            isPerformanceSection = (section == "performance");
             continue;
         }
 
@@ -107,6 +109,14 @@ ConsoleConfig ConfigLoader::load_from_file(const std::string &filename) {
                 command.parameters = params;
             }
             else if (key == "usage") command.usage = value;
+        } else if (isPerformanceSection) {
+            if (key == "threads") config.performance.threads = std::stoi(value);
+            else if (key == "engine") config.performance.engine = value;
+            else if (key == "memory_budget") config.performance.memory_budget = value;
+            else if (key == "dense_threshold") config.performance.dense_threshold = std::stoi(value);
+            else if (key == "output_buffering") config.performance.output_buffering = value;
+            else if (key == "output_buffer_size") config.performance.output_buffer_size = value;
+            else if (key == "spill_dir") config.performance.spill_dir = value;
         } else {
             if (key == "prompt") config.prompt = value;
             else if (key == "welcome_msg") config.welcome_msg = value;
@@ -121,6 +131,7 @@ ConsoleConfig ConfigLoader::load_from_file(const std::string &filename) {
             else if (key == "clear_screen_on_start") config.clear_screen_on_start = parse_bool(value);
             else if (key == "history_size") config.history_size = std::stoi(value);
             else if (key == "press_to_exit") config.press_to_exit = parse_bool(value);
+            else if (key == "memory_budget") config.performance.memory_budget = value; // before [performance] existed
         }
     }
 
@@ -144,6 +155,16 @@ bool ConfigLoader::save_config(const ConsoleConfig &config, const std::string &f
     file << "history_size = " << config.history_size << "\n";
     file << "press_to_exit = " << config.press_to_exit << "\n\n";
 
+    file << "[performance]\n";
+    file << "threads = " << config.performance.threads << "\n";
+    file << "engine = " << config.performance.engine << "\n";
+    file << "memory_budget = " << config.performance.memory_budget << "\n";
+    file << "dense_threshold = " << config.performance.dense_threshold << "\n";
+    file << "output_buffering = " << config.performance.output_buffering << "\n";
+    file << "output_buffer_size = " << config.performance.output_buffer_size << "\n";
+    if (!config.performance.spill_dir.empty()) file << "spill_dir = " << config.performance.spill_dir << "\n";
+    file << "\n";
+
     for (const auto& cmd : config.commands) {
         file << "[command]\n";
         file << "name = " << cmd.name << "\n";
@@ -0,0 +1,203 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/core/job_manager.h"
+
+#include <atomic>
+#include <csignal>
+#include <ranges>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    // Token of the job currently executing on any worker; read by the Ctrl-C handler
+    std::atomic<CancelToken*> current_token{nullptr};
+
+    constexpr char interrupt_hint[] = "\n(no running job; type 'exit' to quit)\n";
+
+#ifdef _WIN32
+    BOOL WINAPI on_console_ctrl(const DWORD type) {
+        if (type != CTRL_C_EVENT) return FALSE;
+        if (CancelToken* token = current_token.load()) token->cancel();
+        else WriteConsoleA(GetStdHandle(STD_OUTPUT_HANDLE), interrupt_hint, sizeof(interrupt_hint) - 1, nullptr, nullptr);
+        return TRUE;
+    }
+#else
+    void on_sigint(int) {
+        if (CancelToken* token = current_token.load()) {
+            token->cancel();
+        } else {
+            [[maybe_unused]] const auto written = write(STDOUT_FILENO, interrupt_hint, sizeof(interrupt_hint) - 1);
+        }
+    }
+#endif
+
+    double elapsed_seconds(const std::chrono::steady_clock::time_point from, const std::chrono::steady_clock::time_point to) {
+        return std::chrono::duration<double>(to - from).count();
+    }
+}
+
+JobManager::JobManager() : worker(&JobManager::worker_loop, this) {}
+
+JobManager::~JobManager() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        for (const auto& job : jobs | std::views::values) job->token.cancel();
+    }
+    queue_cv.notify_all();
+    worker.join();
+}
+
+int JobManager::submit(const std::string &description, Task task) {
+    auto job = std::make_shared<Job>();
+    job->description = description;
+    job->task = std::move(task);
+
+    {
+        std::lock_guard lock(mutex);
+        job->id = next_id++;
+        jobs[job->id] = job;
+        queue.push_back(job);
+    }
+    queue_cv.notify_one();
+    return job->id;
+}
+
+bool JobManager::cancel(const int id) {
+    std::lock_guard lock(mutex);
+    const auto it = jobs.find(id);
+    if (it == jobs.end()) return false;
+
+    Job& job = *it->second;
+    if (job.state != JobState::Queued && job.state != JobState::Running) return false;
+    job.token.cancel();
+    return true;
+}
+
+bool JobManager::wait(const int id, const ProgressCallback &on_progress, JobStatus &status) {
+    std::unique_lock lock(mutex);
+    const auto it = jobs.find(id);
+    if (it == jobs.end()) return false;
+
+    const std::shared_ptr<Job> job = it->second;
+    const auto is_finished = [&job] { return job->state != JobState::Queued && job->state != JobState::Running; };
+
+    while (!finished_cv.wait_for(lock, std::chrono::milliseconds(200), is_finished)) {
+        if (on_progress) {
+            const JobStatus progress = make_status(*job);
+            lock.unlock();
+            on_progress(progress);
+            lock.lock();
+        }
+    }
+
+    status = make_status(*job);
+    status.output = std::move(job->output);
+    jobs.erase(id);
+    return true;
+}
+
+std::vector<JobStatus> JobManager::list() const {
+    std::lock_guard lock(mutex);
+    std::vector<JobStatus> result;
+    result.reserve(jobs.size());
+    for (const auto& job : jobs | std::views::values) result.push_back(make_status(*job));
+    return result;
+}
+
+bool JobManager::has_active_jobs() const {
+    std::lock_guard lock(mutex);
+    return !queue.empty() || current_token.load() != nullptr;
+}
+
+void JobManager::install_interrupt_handler() {
+#ifdef _WIN32
+    SetConsoleCtrlHandler(on_console_ctrl, TRUE);
+#else
+    struct sigaction action{};
+    action.sa_handler = on_sigint;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+#endif
+}
+
+const char* JobManager::state_name(const JobState state) {
+    switch (state) {
+        case JobState::Queued: return "queued";
+        case JobState::Running: return "running";
+        case JobState::Done: return "done";
+        case JobState::Failed: return "failed";
+        case JobState::Cancelled: return "cancelled";
+    }
+    return "unknown";
+}
+
+void JobManager::worker_loop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock lock(mutex);
+            queue_cv.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+
+            job = queue.front();
+            queue.pop_front();
+            job->started = std::chrono::steady_clock::now();
+            job->state = JobState::Running;
+            current_token.store(&job->token);
+        }
+
+        std::ostringstream out;
+        JobState final_state = JobState::Done;
+        std::string error;
+        try {
+            job->token.throw_if_cancelled();
+            job->task(out, job->token);
+        } catch (const OperationCancelled&) {
+            final_state = JobState::Cancelled;
+        } catch (const std::exception& e) {
+            final_state = JobState::Failed;
+            error = e.what();
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            current_token.store(nullptr);
+            job->finished = std::chrono::steady_clock::now();
+            job->output = out.str();
+            job->error = std::move(error);
+            job->state = final_state;
+            job->task = nullptr;
+        }
+        finished_cv.notify_all();
+    }
+}
+
+JobStatus JobManager::make_status(const Job &job) {
+    JobStatus status;
+    status.id = job.id;
+    status.description = job.description;
+    status.state = job.state;
+    status.done = job.token.get_done();
+    status.total = job.token.get_total();
+    status.error = job.error;
+
+    if (job.state == JobState::Running) {
+        status.seconds = elapsed_seconds(job.started, std::chrono::steady_clock::now());
+    } else if (job.state != JobState::Queued) {
+        status.seconds = elapsed_seconds(job.started, job.finished);
+    }
+    return status;
+}
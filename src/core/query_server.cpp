@@ -0,0 +1,354 @@
+// Created by IWOFLEUR on 18.10.2026
+
+#include "../../include/core/query_server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+QueryServer::QueryServer(std::string path, Handler request_handler, unsigned int)
+    : socket_path(std::move(path)), handler(std::move(request_handler)) {
+    throw std::runtime_error("query server needs Unix domain sockets, which this build does not support");
+}
+
+QueryServer::~QueryServer() = default;
+
+QueryServer::Stats QueryServer::stats() const { return {0, 0, 0}; }
+
+QueryClient::QueryClient(const std::string&) {
+    throw std::runtime_error("query client needs Unix domain sockets, which this build does not support");
+}
+
+QueryClient::~QueryClient() = default;
+
+std::string QueryClient::request(std::string_view) { return {}; }
+
+#else
+
+namespace {
+    std::runtime_error socket_error(const std::string& action, const std::string& path) {
+        return std::runtime_error("cannot " + action + " '" + path + "': " + std::strerror(errno));
+    }
+
+    void set_nonblocking(const int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    sockaddr_un socket_address(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("socket path '" + path + "' is too long");
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+
+    /// Writes as much as the socket accepts; returns false if the peer is gone
+    bool send_pending(const int fd, std::string& out) {
+#ifdef MSG_NOSIGNAL
+        constexpr int flags = MSG_NOSIGNAL;
+#else
+        constexpr int flags = 0;
+#endif
+        std::size_t sent = 0;
+        while (sent < out.size()) {
+            const ssize_t written = send(fd, out.data() + sent, out.size() - sent, flags);
+            if (written > 0) sent += static_cast<std::size_t>(written);
+            else if (written == -1 && errno == EINTR) continue;
+            else if (written == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            else return false;
+        }
+        out.erase(0, sent);
+        return true;
+    }
+
+    struct Connection {
+        int fd = -1;
+        std::string in;                 ///< Bytes of an incomplete request line
+        std::string out;                ///< Responses not yet sent
+        std::vector<std::string> lines; ///< Complete requests waiting for a worker
+        std::size_t line_bytes = 0;     ///< Total size of lines
+        bool busy = false;              ///< A batch of this connection is being answered
+        bool eof = false;               ///< No more requests will be read; close once answered
+        bool overflow = false;          ///< An over-long request was dropped; report it after the earlier answers
+    };
+}
+
+QueryServer::QueryServer(std::string path, Handler request_handler, unsigned int threads)
+    : socket_path(std::move(path)), handler(std::move(request_handler)) {
+    const sockaddr_un address = socket_address(socket_path);
+
+    // Replace a socket left behind by a previous run, but never an ordinary file
+    if (struct stat info{}; lstat(socket_path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) throw std::runtime_error("'" + socket_path + "' exists and is not a socket");
+        unlink(socket_path.c_str());
+    }
+
+    int wake_pipe[2] = {-1, -1};
+    try {
+        listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd == -1) throw socket_error("create socket", socket_path);
+        if (bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            throw socket_error("bind", socket_path);
+        }
+        if (listen(listen_fd, SOMAXCONN) != 0) throw socket_error("listen on", socket_path);
+        set_nonblocking(listen_fd);
+
+        if (pipe(wake_pipe) != 0) throw socket_error("create wake pipe for", socket_path);
+        wake_read = wake_pipe[0];
+        wake_write = wake_pipe[1];
+        set_nonblocking(wake_read);
+        set_nonblocking(wake_write);
+    } catch (...) {
+        if (listen_fd != -1) {
+            close(listen_fd);
+            unlink(socket_path.c_str());
+        }
+        if (wake_pipe[0] != -1) close(wake_pipe[0]);
+        if (wake_pipe[1] != -1) close(wake_pipe[1]);
+        throw;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 0; t < threads; t++) workers.emplace_back(&QueryServer::worker_loop, this);
+    event_thread = std::thread(&QueryServer::event_loop, this);
+}
+
+QueryServer::~QueryServer() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    wake();
+
+    event_thread.join();
+    for (auto& worker : workers) worker.join();
+
+    close(listen_fd);
+    close(wake_read);
+    close(wake_write);
+    unlink(socket_path.c_str());
+}
+
+QueryServer::Stats QueryServer::stats() const {
+    return {connection_count.load(), active_count.load(), request_count.load()};
+}
+
+void QueryServer::wake() const {
+    constexpr char signal = 1;
+    // A full pipe already guarantees a wake-up, so a failed write is fine
+    [[maybe_unused]] const auto written = write(wake_write, &signal, 1);
+}
+
+void QueryServer::worker_loop() {
+    while (true) {
+        Batch batch;
+        {
+            std::unique_lock lock(mutex);
+            work_cv.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) return;
+            batch = std::move(pending.front());
+            pending.pop_front();
+        }
+
+        for (const std::string& line : batch.lines) {
+            try {
+                batch.responses += handler(line);
+            } catch (const std::exception& e) {
+                batch.responses += "ERR ";
+                batch.responses += e.what();
+            }
+            batch.responses += '\n';
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            finished.push_back(std::move(batch));
+        }
+        wake();
+    }
+}
+
+void QueryServer::event_loop() {
+    std::unordered_map<int, Connection> clients; // keyed by descriptor
+    std::vector<pollfd> fds;
+    char chunk[16 * 1024];
+
+    while (!stopping) {
+        fds.clear();
+        fds.push_back({wake_read, POLLIN, 0});
+        fds.push_back({listen_fd, POLLIN, 0});
+        for (const auto& [fd, client] : clients) {
+            // Leave a client's bytes in the socket while it has a backlog, so the kernel throttles it
+            const bool readable = !client.eof && client.line_bytes < max_pending_bytes
+                                  && client.out.size() < max_pending_bytes;
+            const short events = static_cast<short>((readable ? POLLIN : 0) | (client.out.empty() ? 0 : POLLOUT));
+            fds.push_back({fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            while (read(wake_read, chunk, sizeof(chunk)) > 0) {}
+
+            std::deque<Batch> done;
+            {
+                std::lock_guard lock(mutex);
+                done.swap(finished);
+            }
+            for (Batch& batch : done) {
+                request_count += batch.lines.size();
+                // The client may have disconnected while its batch was answered
+                if (const auto it = clients.find(batch.client); it != clients.end()) {
+                    it->second.out += batch.responses;
+                    it->second.busy = false;
+                }
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            for (int fd; (fd = accept(listen_fd, nullptr, nullptr)) != -1;) {
+                set_nonblocking(fd);
+                clients[fd].fd = fd;
+                ++connection_count;
+            }
+        }
+
+        std::vector<int> closed;
+        for (std::size_t i = 2; i < fds.size(); i++) {
+            Connection& client = clients.at(fds[i].fd);
+            const short revents = fds[i].revents;
+
+            if (revents & POLLIN) {
+                ssize_t received;
+                do {
+                    received = read(client.fd, chunk, sizeof(chunk));
+                    if (received > 0) client.in.append(chunk, static_cast<std::size_t>(received));
+                } while (received > 0 && client.in.size() < max_pending_bytes);
+                if (received == 0 || (received == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    client.eof = true;
+                }
+
+                std::size_t start = 0;
+                for (std::size_t end; (end = client.in.find('\n', start)) != std::string::npos; start = end + 1) {
+                    std::string line = client.in.substr(start, end - start);
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    client.line_bytes += line.size();
+                    client.lines.push_back(std::move(line));
+                }
+                client.in.erase(0, start);
+
+                if (client.in.size() > max_request_bytes) {
+                    client.in.clear();
+                    client.overflow = true;
+                    client.eof = true;
+                }
+            } else if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                client.eof = true;
+                client.lines.clear();
+                client.line_bytes = 0;
+            }
+
+            if (!client.out.empty() && !send_pending(client.fd, client.out)) {
+                client.eof = true;
+                client.lines.clear();
+                client.line_bytes = 0;
+                client.out.clear();
+            }
+        }
+
+        // Hand every idle connection's pipelined requests to a worker as one batch, unless
+        // the client has not yet read enough of its earlier responses
+        bool dispatched = false;
+        for (auto& [fd, client] : clients) {
+            if (!client.busy && !client.lines.empty() && client.out.size() < max_pending_bytes) {
+                std::lock_guard lock(mutex);
+                pending.push_back({fd, std::move(client.lines), {}});
+                client.lines.clear();
+                client.line_bytes = 0;
+                client.busy = true;
+                dispatched = true;
+            }
+            if (client.overflow && !client.busy && client.lines.empty()) {
+                client.out += "ERR request line too long\n";
+                client.overflow = false;
+                send_pending(fd, client.out);
+            }
+            if (client.eof && !client.busy && client.lines.empty() && client.out.empty()) closed.push_back(fd);
+        }
+        if (dispatched) work_cv.notify_all();
+
+        for (const int fd : closed) {
+            close(fd);
+            clients.erase(fd);
+        }
+        active_count = clients.size();
+    }
+
+    for (const auto& [fd, client] : clients) close(fd);
+    active_count = 0;
+}
+
+QueryClient::QueryClient(const std::string &socket_path) {
+    const sockaddr_un address = socket_address(socket_path);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) throw socket_error("create socket for", socket_path);
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        const std::runtime_error error = socket_error("connect to", socket_path);
+        close(fd);
+        throw error;
+    }
+}
+
+QueryClient::~QueryClient() {
+    close(fd);
+}
+
+std::string QueryClient::request(const std::string_view line) {
+    std::string message(line);
+    message += '\n';
+#ifdef MSG_NOSIGNAL
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif
+    for (std::size_t sent = 0; sent < message.size();) {
+        const ssize_t written = send(fd, message.data() + sent, message.size() - sent, flags);
+        if (written == -1 && errno == EINTR) continue;
+        if (written <= 0) throw std::runtime_error(std::string("query server connection failed: ") + std::strerror(errno));
+        sent += static_cast<std::size_t>(written);
+    }
+
+    char chunk[16 * 1024];
+    std::size_t newline;
+    while ((newline = buffer.find('\n')) == std::string::npos) {
+        const ssize_t received = read(fd, chunk, sizeof(chunk));
+        if (received == -1 && errno == EINTR) continue;
+        if (received <= 0) throw std::runtime_error("query server closed the connection");
+        buffer.append(chunk, static_cast<std::size_t>(received));
+    }
+
+    std::string response = buffer.substr(0, newline);
+    buffer.erase(0, newline + 1);
+    return response;
+}
+
+#endif
@@ -1,8 +1,12 @@
 #include "../include/adapters/console_adapter.h"
 
+#include <fstream>
+
 struct GraphParameters {
     bool is_weight;
     bool is_directed;
+    bool is_batch;
+    std::string script_path;
 };
 
 GraphParameters parse_args(int argc, char **argv);
@@ -11,7 +15,21 @@ void print_help(const char* program_name);
 int main(const int argc, char *argv[]) {
     try {
         const GraphParameters params = parse_args(argc, argv);
+
+        if (!params.script_path.empty()) {
+            std::ifstream script(params.script_path);
+            if (!script.is_open()) {
+                std::cerr << "Error: cannot open script " << params.script_path << std::endl;
+                return EXIT_FAILURE;
+            }
+            GraphConsoleAdapter console(params.is_weight, params.is_directed);
+            return console.run_batch(script);
+        }
+
         GraphConsoleAdapter console(params.is_weight, params.is_directed);
+        if (params.is_batch) {
+            return console.run_batch(std::cin);
+        }
         console.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -28,10 +46,12 @@ GraphParameters parse_args(const int argc, char **argv) {
         {"-w", [](GraphParameters& params) { params.is_weight = true; }},
         {"--weighted", [](GraphParameters& params) { params.is_weight = true; }},
         {"-d", [](GraphParameters& params) { params.is_directed = true; }},
-        {"--directed", [](GraphParameters& params) {params.is_directed = true; }}
+        {"--directed", [](GraphParameters& params) {params.is_directed = true; }},
+        {"-b", [](GraphParameters& params) { params.is_batch = true; }},
+        {"--batch", [](GraphParameters& params) { params.is_batch = true; }}
     };
 
-    GraphParameters params{false, false};
+    GraphParameters params{false, false, false, ""};
 
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -40,6 +60,15 @@ GraphParameters parse_args(const int argc, char **argv) {
             print_help(argv[0]);
         }
 
+        if (arg == "-s" || arg == "--script") {
+            if (i + 1 >= argc) {
+                std::cerr << "Option " << arg << " requires a file argument\nUse -h for help" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            params.script_path = argv[++i];
+            continue;
+        }
+
         if (auto it = options.find(arg); it != options.end()) {
             it->second(params);
         } else {
@@ -55,11 +84,15 @@ GraphParameters parse_args(const int argc, char **argv) {
 void print_help(const char* program_name) {
     std::cout << "Usage: " << program_name << " [OPTIONS]\n"
           << "Options:\n"
-          << "  -w, --weighted    Use weighted graph\n"
-          << "  -d, --directed    Use directed graph\n"
-          << "  -h, --help        Show this help message\n\n"
+          << "  -w, --weighted       Use weighted graph\n"
+          << "  -d, --directed       Use directed graph\n"
+          << "  -s, --script <file>  Run commands from file without prompt, colours or banner\n"
+          << "  -b, --batch          Run commands from stdin without prompt, colours or banner\n"
+          << "  -h, --help           Show this help message\n\n"
+          << "In script and batch modes the exit code is non-zero if any command failed.\n\n"
           << "Examples:\n"
           << "  " << program_name << " -w -d    # Weighted directed graph\n"
           << "  " << program_name << " --weighted    # Weighted undirected graph\n"
-          << "  " << program_name << "          # Unweighted undirected graph\n";
-}
\ No newline at end of file
+          << "  " << program_name << "          # Unweighted undirected graph\n"
+          << "  " << program_name << " --script jobs.txt    # Run commands from jobs.txt\n";
+}